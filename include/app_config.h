@@ -0,0 +1,112 @@
+/*
+ * File: app_config.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Declarative board / application configuration
+ *              논리 GPIO 핀맵, task 주기, UART baud 를 이 파일 한 곳에서 정의.
+ *              X-macro 로 아래 항목을 생성하고 컴파일 타임에 검사한다.
+ *                - gpio_id_t enum, gpio_table (flash)        → gpio.h / gpio.c
+ *                - DDR/PORT 초기값 (포트별 상수 마스크)       → gpioInit()
+ *                - task id enum, TASK_MAX, task 실행 코드     → app.c
+ *                - keypad 행/열 GPIO 표, KEYPAD_ROWS/COLS     → keypad.h / keypad.c
+ *              검사 (_Static_assert): 핀 중복, port/pin 범위, 테이블 ↔ enum 개수,
+ *                                     task 주기 범위, baud 오차 (UART_BAUD_ERR_MAX)
+ */
+
+#ifndef APP_CONFIG_H_
+#define APP_CONFIG_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "gpio_port.h"   // PORT_A ~ PORT_G
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  GPIO MAP                                  */
+/* -------------------------------------------------------------------------- */
+/*
+ * X(id, port, pin, mode)
+ *   id   : 논리 GPIO 이름 (나열 순서 = gpio_id_t 값)
+ *   mode : GPIO_INPUT / GPIO_OUTPUT / GPIO_INPUT_PULLUP
+ * 핀맵 변경 시 이 표만 수정 → app 코드는 수정 불필요.
+ * ⚡ 한 핀을 두 id 에 배정하면 컴파일 에러 (gpio.c).
+ */
+#define APP_GPIO_MAP(X)                                                                         \
+    X(GPIO_LED,       PORT_B, 0, GPIO_OUTPUT)        /* Example LED Output                   */ \
+    X(GPIO_BUTTON,    PORT_E, 6, GPIO_INPUT_PULLUP)  /* Example Input Button (INT6, exti.h)  */ \
+    X(GPIO_LCD_RS,    PORT_C, 0, GPIO_OUTPUT)        /* HD44780 RS (lcd.h)                   */ \
+    X(GPIO_LCD_E,     PORT_C, 1, GPIO_OUTPUT)        /* HD44780 E                            */ \
+    X(GPIO_LCD_D4,    PORT_C, 2, GPIO_OUTPUT)        /* HD44780 D4 (4bit, R/W 는 GND 고정)   */ \
+    X(GPIO_LCD_D5,    PORT_C, 3, GPIO_OUTPUT)        /* HD44780 D5                           */ \
+    X(GPIO_LCD_D6,    PORT_C, 4, GPIO_OUTPUT)        /* HD44780 D6                           */ \
+    X(GPIO_LCD_D7,    PORT_C, 5, GPIO_OUTPUT)        /* HD44780 D7                           */ \
+    X(GPIO_OW_DQ,     PORT_G, 0, GPIO_INPUT)         /* 1-Wire DQ (onewire.c 가 DDR 로 구동) */ \
+    X(GPIO_KEY_ROW0,  PORT_A, 0, GPIO_INPUT)         /* Key 행 0 (keypad.c 가 DDR 로 구동)   */ \
+    X(GPIO_KEY_ROW1,  PORT_A, 1, GPIO_INPUT)         /* Key 행 1                             */ \
+    X(GPIO_KEY_ROW2,  PORT_A, 2, GPIO_INPUT)         /* Key 행 2                             */ \
+    X(GPIO_KEY_ROW3,  PORT_A, 3, GPIO_INPUT)         /* Key 행 3                             */ \
+    X(GPIO_KEY_COL0,  PORT_A, 4, GPIO_INPUT_PULLUP)  /* Key 열 0 (열은 같은 포트 연속 핀)    */ \
+    X(GPIO_KEY_COL1,  PORT_A, 5, GPIO_INPUT_PULLUP)  /* Key 열 1                             */ \
+    X(GPIO_KEY_COL2,  PORT_A, 6, GPIO_INPUT_PULLUP)  /* Key 열 2                             */ \
+    X(GPIO_KEY_COL3,  PORT_A, 7, GPIO_INPUT_PULLUP)  /* Key 열 3                             */ \
+    APP_GPIO_MAP_BENCH(X)                            /* env:bench 전용 (아래)                */ \
+ /* X(GPIO_SPI_CS,    PORT_C, 3, GPIO_OUTPUT)           SPI Chip Select (PC3 = LCD_D5 충돌)  */
+
+/*
+ * env:bench / env:native_bench 전용 핀 (-D_BENCH)
+ *   software PWM ISR 측정용 → bench 이미지의 다른 드라이버(LCD 등)가 쓰지 않는 PF0 ~ PF3
+ */
+#ifdef _BENCH
+#define APP_GPIO_MAP_BENCH(X)                                                                   \
+    X(GPIO_BENCH_PWM0, PORT_F, 0, GPIO_OUTPUT)       /* software PWM ch0                     */ \
+    X(GPIO_BENCH_PWM1, PORT_F, 1, GPIO_OUTPUT)       /* software PWM ch1                     */ \
+    X(GPIO_BENCH_PWM2, PORT_F, 2, GPIO_OUTPUT)       /* software PWM ch2                     */ \
+    X(GPIO_BENCH_PWM3, PORT_F, 3, GPIO_OUTPUT)       /* software PWM ch3                     */
+#else
+#define APP_GPIO_MAP_BENCH(X)
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 KEYPAD MAP                                 */
+/* -------------------------------------------------------------------------- */
+/*
+ * X(id) : APP_GPIO_MAP 의 논리 GPIO, 나열 순서 = 행/열 번호 (1 ~ 8 개)
+ *   행 : 아무 포트, GPIO_INPUT
+ *   열 : 같은 포트의 연속 핀 오름차순 (COL 0 = 최하위), GPIO_INPUT_PULLUP
+ * 행/열 수는 이 표에서 계산 (KEYPAD_ROWS/COLS) → 행/열 추가 시 GPIO MAP 과 이 표만 수정.
+ */
+#define APP_KEYPAD_ROWS(X)                                                                      \
+    X(GPIO_KEY_ROW0)                                                                            \
+    X(GPIO_KEY_ROW1)                                                                            \
+    X(GPIO_KEY_ROW2)                                                                            \
+    X(GPIO_KEY_ROW3)
+
+#define APP_KEYPAD_COLS(X)                                                                      \
+    X(GPIO_KEY_COL0)                                                                            \
+    X(GPIO_KEY_COL1)                                                                            \
+    X(GPIO_KEY_COL2)                                                                            \
+    X(GPIO_KEY_COL3)
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  TASK MAP                                  */
+/* -------------------------------------------------------------------------- */
+/*
+ * X(handler, period_ms)
+ *   나열 순서 = 같은 tick 에서 실행 순서 = trace 이벤트 번호 (TRACE_EVT_TASK)
+ *   period_ms : 1 ~ 60000
+ */
+#define APP_TASK_MAP(X)                                                                         \
+    X(task_1ms,       1)                             /* LCD, 1-Wire, keypad scan             */ \
+    X(task_50ms,     50)                             /* key 이벤트 처리                      */ \
+    X(task_100ms,   100)                                                                        \
+    X(task_500ms,   500)                             /* LED, 온도 측정 예약                  */
+
+
+/* -------------------------------------------------------------------------- */
+/*                                    UART                                    */
+/* -------------------------------------------------------------------------- */
+#define APP_UART_BAUD       38400   // USART0 host link (platformio.ini monitor_speed 와 일치)
+
+#endif /* APP_CONFIG_H_ */
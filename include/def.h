@@ -25,6 +25,7 @@
 #define MCU_ATMEGA128   1
 #define MCU_STM32F4     2
 #define MCU_ESP32       3
+#define MCU_HOST        4       // Linux/POSIX native (시뮬레이션, 단위 테스트, 벤치마크)
 
 // 현재 MCU 선택
 #ifndef MCU_TYPE
@@ -57,6 +58,14 @@
 #include "driver/uart.h"
 #define F_CPU 240000000UL
 
+#elif (MCU_TYPE == MCU_HOST)
+
+/* --------------------------------- HOST ----------------------------------- */
+#include <stdio.h>
+#ifndef F_CPU
+#define F_CPU 16000000UL        // 타이밍/baud 계산용 (ATmega128과 동일)
+#endif
+
 #else
 #error "Unknown MCU_TYPE"
 #endif
@@ -0,0 +1,89 @@
+/*
+ * File: capture.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Input-capture frequency / pulse-width measurement (Timer3 ICP3)
+ *              엣지 시각을 하드웨어로 캡처(62.5ns @16MHz)하고 overflow 카운트로
+ *              32bit 확장, 주기 링버퍼 평균으로 주파수/duty/RPM을 고정소수점 계산.
+ *
+ * ⚡ ICP3 = PE7. Timer3 를 normal mode 로 독점 사용
+ *    → PWM_HW_OC3A/B/C 와 동시 사용 불가.
+ */
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               CAPTURE CONFIG                               */
+/* -------------------------------------------------------------------------- */
+#ifndef CAPTURE_RING_SIZE
+#define CAPTURE_RING_SIZE       8       // 평균 낼 주기 개수 (2의 거듭제곱)
+#endif
+
+#ifndef CAPTURE_TIMEOUT_MS
+#define CAPTURE_TIMEOUT_MS      500     // 이 시간 동안 엣지 없으면 신호 없음 (0 반환)
+#endif
+
+#define CAPTURE_TICK_HZ         F_CPU   // prescaler 1 → 1 tick = 1 CPU cycle
+
+
+/* -------------------------------------------------------------------------- */
+/*                                CAPTURE MODE                                */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    CAPTURE_MODE_PERIOD = 0,   // 상승 엣지만 캡처 (주기/주파수/RPM, ISR 최소)
+    CAPTURE_MODE_DUTY          // 양 엣지 캡처 (추가로 HIGH 폭/duty, ISR 2배)
+} capture_mode_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start Timer3 input capture on ICP3 (PE7, noise canceler on)
+ *
+ * ISR 비용: 미측정 (명령어 수 기준 엣지당 약 70 cycle → 10kHz PERIOD 모드에서 16MHz의 약 4.4%)
+ *   env:bench 의 TIMER3_CAPT_vect 항목으로 확인.
+ * CAPTURE_TIMEOUT_MS 이상 공백 후 첫 엣지는 링버퍼를 비우고 새로 시작.
+ *
+ * @return false = Timer3 가 PWM 으로 사용 중
+ */
+bool captureInit(capture_mode_t mode);
+
+/**
+ * @brief  Average period
+ * @return [tick] (1 tick = 1/F_CPU s), 신호 없음 = 0
+ */
+uint32_t captureGetPeriod(void);
+
+/**
+ * @brief  Average frequency
+ * @return [0.01 Hz] (예: 1000000 = 10kHz), 신호 없음 = 0
+ */
+uint32_t captureGetFreq(void);
+
+/**
+ * @brief  Average duty (CAPTURE_MODE_DUTY 전용)
+ * @return [0.1 %] (0 ~ 1000)
+ */
+uint16_t captureGetDuty(void);
+
+/**
+ * @brief  Rotation speed
+ * @param  pulses_per_rev 1회전당 펄스 수
+ * @return [rpm]
+ */
+uint32_t captureGetRpm(uint8_t pulses_per_rev);
+
+/**
+ * @brief  Total captured periods since init
+ */
+uint32_t captureGetCount(void);
+
+#endif /* CAPTURE_H_ */
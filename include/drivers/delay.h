@@ -13,6 +13,13 @@
 #include "def.h"
 
 
+/* -------------------------------------------------------------------------- */
+/*                               TICK COUNTER                                 */
+/* -------------------------------------------------------------------------- */
+/* ⚡ trace 등 저비용 타임스탬프 전용 (읽기만 허용, 일반 코드는 millis() 사용) */
+extern volatile uint32_t g_ms;
+
+
 /* -------------------------------------------------------------------------- */
 /*                                API PROTOTYPES                              */
 /* -------------------------------------------------------------------------- */
@@ -23,4 +30,23 @@ void delay_ms(uint32_t ms);
 void delay_us(uint32_t us);
 
 
+#if (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                              HOST-ONLY CONTROL                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Select time source
+ * @param  enable true  = 가상 시계 (delayHostAdvanceUs()로만 진행)
+ *                false = CLOCK_MONOTONIC 실시간 (기본값)
+ */
+void delayHostSetVirtual(bool enable);
+
+/**
+ * @brief  Advance virtual clock (가상 시계 모드에서만 유효)
+ * @param  us 진행할 시간 [µs]
+ */
+void delayHostAdvanceUs(uint32_t us);
+#endif
+
+
 #endif /* DELAY_H_ */
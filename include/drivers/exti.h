@@ -0,0 +1,85 @@
+/*
+ * File: exti.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: External interrupt (INT0 ~ INT7) driver
+ *              논리 GPIO 테이블의 핀을 INTn 에 연결하고, 엣지마다 ISR 에서
+ *              micros() 타임스탬프를 찍어 이벤트 큐에 넣는다.
+ *              큐는 task 에서 extiRead() 로 비운다.
+ *
+ * 핀 매핑 (ATmega128):
+ *   INT0~3 = PD0~PD3  (⚡ PD2/PD3 = USART1 RXD1/TXD1 과 공유)
+ *   INT4~7 = PE4~PE7  (⚡ PE4/PE5 = OC3B/OC3C, PE7 = ICP3 과 공유)
+ */
+
+#ifndef EXTI_H_
+#define EXTI_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+#include "gpio.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 EXTI CONFIG                                */
+/* -------------------------------------------------------------------------- */
+#ifndef EXTI_QUEUE_SIZE
+#define EXTI_QUEUE_SIZE     16      // 이벤트 큐 크기 (2의 거듭제곱, 최대 256)
+#endif
+
+#define EXTI_LINE_MAX       8       // INT0 ~ INT7
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                             */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    EXTI_EDGE_FALLING = 0,   // 하강 엣지
+    EXTI_EDGE_RISING,        // 상승 엣지
+    EXTI_EDGE_BOTH           // 양 엣지 (INT0~3 은 ISR 에서 감지 엣지를 교대로 전환)
+} exti_edge_t;
+
+typedef struct
+{
+    gpio_id_t id;            // 논리 GPIO
+    uint8_t   level;         // 엣지 직후 핀 레벨 (1 = HIGH)
+    uint32_t  us;            // 엣지 시각 (micros() 와 같은 기준, 4µs 분해능)
+} exti_evt_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Enable external interrupt on logical GPIO
+ *         (방향/풀업은 gpio_table 설정을 따름)
+ * @param  id    논리 GPIO (INT0~7 핀이어야 함)
+ * @param  edge  감지 엣지
+ * @return false = INTn 핀이 아님
+ */
+bool extiAttach(gpio_id_t id, exti_edge_t edge);
+
+/**
+ * @brief  Disable external interrupt on logical GPIO
+ */
+void extiDetach(gpio_id_t id);
+
+/**
+ * @brief  Pop oldest edge event (task 에서 호출)
+ * @return true = 이벤트 있음
+ */
+bool extiRead(exti_evt_t *p_evt);
+
+/**
+ * @brief  Total edges seen on pin (큐 overflow 포함)
+ */
+uint32_t extiGetEdgeCount(gpio_id_t id);
+
+/**
+ * @brief  Edges dropped on pin because queue was full
+ */
+uint16_t extiGetOverflow(gpio_id_t id);
+
+#endif /* EXTI_H_ */
@@ -15,6 +15,7 @@
 /* -------------------------------------------------------------------------- */
 #include "def.h"
 #include "gpio_port.h"   // PORT_A ~ PORT_G 공용 포트 정의
+#include "app_config.h"  // APP_GPIO_MAP (논리 GPIO 핀맵)
 
 
 /* -------------------------------------------------------------------------- */
@@ -23,14 +24,14 @@
 /*
  * 애플리케이션은 PORT/PIN 정보를 몰라도 되며,
  * 아래 논리 ID만 사용하여 GPIO 접근 가능.
- * 핀맵 변경 시 gpio_table만 수정하면 되고,
- * app.c는 수정하지 않아도 됨 → MCU 독립성 확보.
+ * ID 와 핀맵은 app_config.h 의 APP_GPIO_MAP 한 곳에서 생성
+ * → enum 과 gpio_table 이 어긋날 수 없음, app.c는 수정하지 않아도 됨.
  */
 typedef enum
 {
-    GPIO_LED = 0,        // Example LED Output
-    // GPIO_BUTTON,         // Example Input Button
-    // GPIO_SPI_CS,         // SPI Chip Select
+#define GPIO_X_ID(id, port, pin, mode)      id,
+    APP_GPIO_MAP(GPIO_X_ID)
+#undef GPIO_X_ID
 
     GPIO_MAX             // Enum Count (항상 마지막에 위치)
 } gpio_id_t;
@@ -42,7 +43,8 @@ typedef enum
 typedef enum
 {
     GPIO_INPUT = 0,      // 입력
-    GPIO_OUTPUT          // 출력
+    GPIO_OUTPUT,         // 출력
+    GPIO_INPUT_PULLUP    // 입력 + 내부 풀업
 } gpio_mode_t;
 
 
@@ -56,11 +58,30 @@ typedef enum
 } gpio_state_t;
 
 
+/* -------------------------------------------------------------------------- */
+/*                           GPIO REGISTER HANDLE                             */
+/* -------------------------------------------------------------------------- */
+/*
+ * 고속 경로(ISR, 포트 단위 일괄 갱신) 전용.
+ * 논리 ID → 포트 레지스터 + 비트 마스크를 한 번 조회하여 캐시해 두고 사용.
+ * 일반 애플리케이션 코드는 gpioWrite/gpioRead 사용.
+ */
+typedef struct
+{
+    volatile uint8_t *ddr;   // 방향 레지스터 (DDRx)
+    volatile uint8_t *out;   // 출력 레지스터 (PORTx)
+    volatile uint8_t *in;    // 입력 레지스터 (PINx)
+    uint8_t port;            // 논리 포트 번호 (PORT_A ~ PORT_G)
+    uint8_t mask;            // 핀 비트 마스크
+} gpio_reg_t;
+
+
 /* -------------------------------------------------------------------------- */
 /*                                API PROTOTYPES                              */
 /* -------------------------------------------------------------------------- */
 /**
  * @brief  Initialize all logical GPIOs defined in gpio_table
+ *         (포트별 DDR/PORT 마스크는 컴파일 타임 상수, 루프 없음)
  */
 void gpioInit(void);
 
@@ -84,4 +105,33 @@ void gpioToggle(gpio_id_t id);
  */
 uint8_t gpioRead(gpio_id_t id);
 
+/**
+ * @brief  Resolve logical GPIO to port registers and bit mask
+ * @param  id     Logical GPIO ID
+ * @param  p_reg  결과 저장
+ * @return true = 성공, false = 잘못된 ID/포트
+ */
+bool gpioGetReg(gpio_id_t id, gpio_reg_t *p_reg);
+
+
+#if (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                              HOST TEST HOOKS                               */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Return current output latch level (PORTx bit)
+ */
+uint8_t gpioHostGetOutput(gpio_id_t id);
+
+/**
+ * @brief  Return configured direction (DDRx bit)
+ */
+gpio_mode_t gpioHostGetMode(gpio_id_t id);
+
+/**
+ * @brief  Drive simulated input level seen by gpioRead()
+ */
+void gpioHostSetInput(gpio_id_t id, gpio_state_t state);
+#endif
+
 #endif /* GPIO_H_ */
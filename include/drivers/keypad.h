@@ -0,0 +1,88 @@
+/*
+ * File: keypad.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Key matrix scanner (최대 8 x 8, non-blocking)
+ *              1ms tick 마다 행 1개 구동 + 열 포트 1회 읽기,
+ *              행 단위로 모든 열을 vertical counter 로 동시에 debounce,
+ *              ghost(사각형 3키 눌림) 감지 시 새 눌림 보류, 이벤트는 큐로 전달.
+ *
+ * 핀 (app_config.h APP_GPIO_MAP):
+ *   행 GPIO_KEY_ROW0 ~ : 아무 포트, GPIO_INPUT (open-drain: DDR 로만 Low 구동)
+ *   열 GPIO_KEY_COL0 ~ : 같은 포트의 연속 핀 오름차순, GPIO_INPUT_PULLUP
+ *   눌린 키 = 구동 행과 연결된 열이 Low.
+ *   행/열 목록과 개수는 app_config.h APP_KEYPAD_ROWS/APP_KEYPAD_COLS 에서 생성.
+ *
+ * debounce: 행마다 KEYPAD_ROWS ms 간격으로 4회 연속 같은 값 → 4x4 16ms, 8x8 32ms.
+ */
+
+#ifndef KEYPAD_H_
+#define KEYPAD_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+#include "app_config.h"  // APP_KEYPAD_ROWS / APP_KEYPAD_COLS
+
+
+/* -------------------------------------------------------------------------- */
+/*                                KEYPAD CONFIG                               */
+/* -------------------------------------------------------------------------- */
+#define KEYPAD_X_COUNT(id)  + 1
+#define KEYPAD_ROWS         (0 APP_KEYPAD_ROWS(KEYPAD_X_COUNT))    // 1 ~ 8 (#if 에서도 사용 가능)
+#define KEYPAD_COLS         (0 APP_KEYPAD_COLS(KEYPAD_X_COUNT))    // 1 ~ 8
+
+#ifndef KEYPAD_QUEUE_SIZE
+#define KEYPAD_QUEUE_SIZE   8       // 이벤트 큐 크기 (2의 거듭제곱, 최대 256)
+#endif
+
+#define KEYPAD_KEY(row, col)    ((uint8_t)((row) * KEYPAD_COLS + (col)))   // key 번호
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                             */
+/* -------------------------------------------------------------------------- */
+typedef struct
+{
+    uint8_t key;            // KEYPAD_KEY(row, col)
+    bool    pressed;        // true = 눌림, false = 뗌
+} keypad_evt_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Resolve row/column pins and drive first row
+ * @return false = 열 핀이 한 포트의 연속 핀이 아님 (keypadScan() 동작 안 함)
+ */
+bool keypadInit(void);
+
+/**
+ * @brief  Scan one row (1ms task 에서 호출)
+ *         읽기 1회 + 행 전환 + vertical counter, 변화가 있을 때만 이벤트 생성.
+ */
+void keypadScan(void);
+
+/**
+ * @brief  Pop oldest key event
+ * @return true = 이벤트 있음
+ */
+bool keypadRead(keypad_evt_t *p_evt);
+
+/**
+ * @brief  Reported (debounce 완료, ghost 제외) key state
+ */
+bool keypadIsPressed(uint8_t key);
+
+/**
+ * @brief  Number of times a row's new presses were held back by ghosting
+ */
+uint16_t keypadGetGhostCount(void);
+
+/**
+ * @brief  Events dropped because queue was full
+ */
+uint16_t keypadGetOverflow(void);
+
+#endif /* KEYPAD_H_ */
@@ -0,0 +1,95 @@
+/*
+ * File: lcd.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Non-blocking HD44780 character LCD driver (4bit)
+ *              애플리케이션은 RAM framebuffer 에만 쓰고 (memcpy 비용),
+ *              lcdUpdate() 가 1ms 마다 LCD 와 다른 셀만 1바이트씩 전송한다.
+ *              긴 대기(전원 인가, 초기화)는 soft_timer 로 스케줄 → busy-wait 없음.
+ *
+ * 핀: 논리 GPIO GPIO_LCD_RS / GPIO_LCD_E / GPIO_LCD_D4 ~ D7 (R/W = GND)
+ */
+
+#ifndef LCD_H_
+#define LCD_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 LCD CONFIG                                 */
+/* -------------------------------------------------------------------------- */
+#ifndef LCD_COLS
+#define LCD_COLS            16      // 가로 문자 수
+#endif
+
+#ifndef LCD_ROWS
+#define LCD_ROWS            2       // 줄 수 (1 ~ 4)
+#endif
+
+/*
+ * 1ms tick 당 전송 바이트 수 = 1
+ *   셀 1개 ≈ 1 tick (주소가 연속이 아니면 set-address 1 tick 추가)
+ *   16x2 전체 갱신 ≈ 34ms (추정: 32 tick + 줄 주소 2 tick, LCD 실측 아님),
+ *   일부 셀 변경 시 변경된 셀 수 만큼만 소요.
+ */
+#define LCD_CMD_US          50      // 일반 명령/데이터 실행 시간 (datasheet 37µs + 여유)
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start LCD initialization (non-blocking)
+ *         framebuffer 를 공백으로 채우고 초기화 시퀀스를 예약한다.
+ *         실제 명령 전송은 lcdUpdate() 에서 진행. gpioInit() 이후 호출.
+ */
+void lcdInit(void);
+
+/**
+ * @brief  LCD state machine step (1ms task 에서 호출)
+ *         초기화 단계 진행 또는 변경된 셀 1바이트 전송.
+ */
+void lcdUpdate(void);
+
+/**
+ * @brief  true = 초기화 완료 (framebuffer 반영 중)
+ */
+bool lcdIsReady(void);
+
+/**
+ * @brief  true = framebuffer 와 LCD 화면이 일치 (전송할 셀 없음)
+ */
+bool lcdIsSynced(void);
+
+/**
+ * @brief  Fill framebuffer with spaces, cursor → (0, 0)
+ */
+void lcdClear(void);
+
+/**
+ * @brief  Set framebuffer write position
+ * @param  col 0 ~ LCD_COLS-1
+ * @param  row 0 ~ LCD_ROWS-1
+ */
+void lcdSetCursor(uint8_t col, uint8_t row);
+
+/**
+ * @brief  Write string at cursor (줄 끝에서 잘림, 다음 줄로 넘어가지 않음)
+ */
+void lcdPrint(const char *str);
+
+/**
+ * @brief  Write string at (col, row)
+ */
+void lcdPrintAt(uint8_t col, uint8_t row, const char *str);
+
+/**
+ * @brief  Replace whole framebuffer
+ * @param  frame LCD_ROWS × LCD_COLS 바이트 (행 우선, NUL 불필요)
+ */
+void lcdWriteFrame(const char *frame);
+
+#endif /* LCD_H_ */
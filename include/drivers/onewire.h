@@ -0,0 +1,114 @@
+/*
+ * File: onewire.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Timer-driven 1-Wire bus master + DS18B20 temperature
+ *              reset / presence / bit slot 은 Timer0 compare ISR 이 생성,
+ *              애플리케이션은 동작(ROM search, convert, read scratchpad)을
+ *              큐에 넣고 onewireUpdate() 가 1ms task 에서 순서대로 진행한다.
+ *              750ms 변환 대기는 soft_timer → main loop 블로킹 없음.
+ *
+ * 핀: 논리 GPIO GPIO_OW_DQ (open-drain 에뮬레이션, 외부 4.7kΩ 풀업 필수)
+ * ⚡ Timer0 를 CTC 모드로 독점 사용 → PWM_HW_OC0 와 동시 사용 불가.
+ *    DS18B20 은 외부 전원(VDD) 연결 기준 (parasite power strong pull-up 미지원).
+ */
+
+#ifndef ONEWIRE_H_
+#define ONEWIRE_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               ONEWIRE CONFIG                               */
+/* -------------------------------------------------------------------------- */
+#ifndef ONEWIRE_DEV_MAX
+#define ONEWIRE_DEV_MAX         8       // ROM search 로 저장할 최대 디바이스 수
+#endif
+
+#ifndef ONEWIRE_QUEUE_SIZE
+#define ONEWIRE_QUEUE_SIZE      16      // 동작 큐 크기 (2의 거듭제곱, 최대 256)
+#endif
+
+#define ONEWIRE_CONVERT_MS      750     // DS18B20 12bit 변환 시간 (datasheet max)
+#define ONEWIRE_DEV_ALL         0xFF    // convert: 버스 전체 (Skip ROM)
+#define ONEWIRE_TEMP_INVALID    INT16_MIN
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Initialize 1-Wire master on GPIO_OW_DQ (Timer0 CTC, 정지 상태)
+ *
+ * ISR 비용 (추정): bit slot 당 ISR 2회, write-1/read 는 ISR 내 짧은 펄스(≤ 10µs)
+ *   → read scratchpad 1회(reset + 80bit write + 72bit read) ≈ ISR 약 1.5ms 누적,
+ *     실제 버스 시간 약 12ms 동안 분산. main loop 비용은 동작당 수십 µs (CRC8).
+ *
+ * @return false = Timer0 가 PWM 으로 사용 중, 또는 GPIO_OW_DQ 오류
+ */
+bool onewireInit(void);
+
+/**
+ * @brief  Queue ROM search (결과: onewireGetCount(), onewireGetRom())
+ *         CRC 가 맞는 ROM 만 최대 ONEWIRE_DEV_MAX 개 저장.
+ * @return false = 큐 가득 참
+ */
+bool onewireQueueSearch(void);
+
+/**
+ * @brief  Queue temperature conversion (완료 = 전송 후 ONEWIRE_CONVERT_MS 경과)
+ * @param  dev 디바이스 index, 또는 ONEWIRE_DEV_ALL (모든 센서 동시 변환)
+ * @return false = 큐 가득 참
+ */
+bool onewireQueueConvert(uint8_t dev);
+
+/**
+ * @brief  Queue read scratchpad (CRC 확인 후 온도 갱신)
+ * @param  dev 디바이스 index
+ * @return false = 큐 가득 참 또는 잘못된 index
+ */
+bool onewireQueueRead(uint8_t dev);
+
+/**
+ * @brief  Queue convert(all) + read for every found device
+ * @return false = 큐 공간 부족 (아무것도 넣지 않음)
+ */
+bool onewireQueueReadAll(void);
+
+/**
+ * @brief  Operation state machine (1ms task 에서 호출)
+ *         버스 동작 완료 처리(CRC, 온도 변환)와 다음 동작 시작만 수행 → 수 µs.
+ */
+void onewireUpdate(void);
+
+/**
+ * @brief  true = 실행 중이거나 대기 중인 동작 있음
+ */
+bool onewireIsBusy(void);
+
+/**
+ * @brief  Number of devices found by last ROM search
+ */
+uint8_t onewireGetCount(void);
+
+/**
+ * @brief  Copy 64bit ROM code of device
+ * @return false = 잘못된 index
+ */
+bool onewireGetRom(uint8_t dev, uint8_t *p_rom);
+
+/**
+ * @brief  Last valid temperature of device
+ * @return [0.01°C] (예: 2531 = 25.31°C), 읽은 적 없음 = ONEWIRE_TEMP_INVALID
+ */
+int16_t onewireGetTemp(uint8_t dev);
+
+/**
+ * @brief  Failed transactions (presence 없음, CRC 오류)
+ */
+uint16_t onewireGetErrCount(void);
+
+#endif /* ONEWIRE_H_ */
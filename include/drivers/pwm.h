@@ -0,0 +1,109 @@
+/*
+ * File: pwm.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Multi-channel PWM engine
+ *              - Hardware PWM : Timer0 / Timer2 / Timer3 compare output
+ *              - Software PWM : 임의의 논리 GPIO, Timer2 ISR 하나로
+ *                               정렬된 엣지 테이블을 따라 포트 단위 일괄 갱신
+ *
+ * Timer 할당:
+ *   Timer0 : PWM_HW_OC0  또는  1-Wire master (동시 사용 불가)
+ *   Timer2 : software PWM 엔진  또는  PWM_HW_OC2 (동시 사용 불가)
+ *   Timer3 : PWM_HW_OC3A/B/C (3채널 공통 주파수), input capture 와 동시 사용 불가
+ */
+
+#ifndef PWM_H_
+#define PWM_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+#include "gpio.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 PWM CONFIG                                 */
+/* -------------------------------------------------------------------------- */
+#define PWM_DUTY_MAX        255     // duty 0 = 항상 LOW, 255 = 항상 HIGH
+
+#ifndef PWM_SW_CH_MAX
+#define PWM_SW_CH_MAX       8       // software PWM 논리 채널 수
+#endif
+
+#ifndef PWM_SW_PORT_MAX
+#define PWM_SW_PORT_MAX     2       // software PWM 채널이 걸칠 수 있는 포트 수
+#endif
+
+/*
+ * Software PWM 주기 = 256 × Timer2 tick
+ *   prescaler  64 → tick 4µs, 주기 1.024ms (976Hz)  ← 기본
+ *   prescaler 256 → tick 16µs, 주기 4.096ms (244Hz)
+ */
+#ifndef PWM_SW_PRESCALER
+#define PWM_SW_PRESCALER    64
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/*                            HARDWARE PWM CHANNEL                            */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    PWM_HW_OC0 = 0,      // Timer0 OC0  (PB4), 8bit (1-Wire 사용 시 불가)
+    PWM_HW_OC2,          // Timer2 OC2  (PB7), 8bit (software PWM 사용 시 불가)
+    PWM_HW_OC3A,         // Timer3 OC3A (PE3), 16bit
+    PWM_HW_OC3B,         // Timer3 OC3B (PE4), 16bit
+    PWM_HW_OC3C,         // Timer3 OC3C (PE5), 16bit
+
+    PWM_HW_MAX           // 채널 개수 (항상 마지막에 위치)
+} pwm_hw_ch_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start hardware PWM channel (phase correct PWM)
+ *         OCRx 는 TOP에서 갱신되므로 duty 변경은 주기 경계에서 glitch 없이 적용.
+ *         Timer0/2 : F_CPU / (N × 510), N = 가장 가까운 prescaler
+ *         Timer3   : F_CPU / (2 × N × TOP), 해상도가 최대인 N 선택
+ *                    (OC3A/B/C 공통 주파수, 마지막 설정값 적용 → 다른 채널 OCR 은 저장된 duty 로 재계산)
+ * @param  ch      PWM_HW_xxx
+ * @param  freq_hz 원하는 PWM 주파수 [Hz]
+ * @return false = 잘못된 채널/주파수, OC0 요청 시 1-Wire 동작 중,
+ *                 OC2 요청 시 software PWM 동작 중,
+ *                 또는 OC3x 요청 시 Timer3 input capture 동작 중
+ */
+bool pwmHwInit(pwm_hw_ch_t ch, uint32_t freq_hz);
+
+/**
+ * @brief  Set hardware PWM duty
+ * @param  duty 0 ~ PWM_DUTY_MAX
+ */
+void pwmHwSetDuty(pwm_hw_ch_t ch, uint8_t duty);
+
+/**
+ * @brief  Start software PWM engine on Timer2
+ * @return false = PWM_HW_OC2 가 이미 Timer2 사용 중
+ */
+bool pwmSwInit(void);
+
+/**
+ * @brief  Bind software PWM channel to logical GPIO (출력으로 설정, duty 0)
+ *         이미 attach 된 채널은 이전 핀을 LOW 로 두고 해제 (ISR 이 더 이상 구동하지 않음).
+ * @param  ch  0 ~ PWM_SW_CH_MAX-1
+ * @param  id  논리 GPIO
+ * @return false = 잘못된 채널/GPIO, 또는 PWM_SW_PORT_MAX 초과 포트
+ */
+bool pwmSwAttach(uint8_t ch, gpio_id_t id);
+
+/**
+ * @brief  Set software PWM duty
+ *         정렬된 엣지 테이블을 비활성 버퍼에 다시 만들고,
+ *         ISR이 다음 주기 시작에서 교체 → glitch 없이 적용.
+ * @param  duty 0 ~ PWM_DUTY_MAX
+ */
+void pwmSwSetDuty(uint8_t ch, uint8_t duty);
+
+#endif /* PWM_H_ */
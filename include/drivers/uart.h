@@ -2,7 +2,8 @@
  * File: uart.h
  * Author: Young Kwan CHO, Lilith
  * Description: ATmega128 UART HAL Wrapper
- *              Minimal TX-only UART for debugging/log output.
+ *              Instance-based interrupt-driven driver for USART0 / USART1.
+ *              uartInit/uartWrite/uartPrint 는 USART0 용 thin wrapper.
  */
 
 #ifndef UART_H_
@@ -14,16 +15,120 @@
 #include "def.h"
 
 
+/* -------------------------------------------------------------------------- */
+/*                                 UART CONFIG                                */
+/* -------------------------------------------------------------------------- */
+#ifndef UART_BAUD_ERR_MAX
+#define UART_BAUD_ERR_MAX   200     // 허용 baud 오차 [0.01%] (±2.00%, 8N1 기준)
+#endif
+
+#ifndef UART_RX_BUF_SIZE
+#define UART_RX_BUF_SIZE    64      // 채널별 수신 링버퍼 (2의 거듭제곱, 최대 256)
+#endif
+
+#ifndef UART_TX_BUF_SIZE
+#define UART_TX_BUF_SIZE    64      // 채널별 송신 링버퍼 (2의 거듭제곱, 최대 256)
+#endif
+
+/* 컴파일 타임 |baud 오차| [0.01%]: uartInit() 과 같은 반올림 UBRR, normal/U2X 중 작은 값 */
+/* 상수 baud 를 _Static_assert(UART_BAUD_ERR_CONST(b) <= UART_BAUD_ERR_MAX) 로 검사     */
+#define UART_BAUD_N(baud, div)          ((F_CPU + (div) * (baud) / 2) / ((div) * (baud)))   // UBRR + 1
+#define UART_BAUD_NC(baud, div)         (UART_BAUD_N(baud, div) < 1 ? 1ULL : \
+                                         UART_BAUD_N(baud, div) > 4096 ? 4096ULL : UART_BAUD_N(baud, div))
+#define UART_BAUD_ACT(baud, div)        ((F_CPU + (div) * UART_BAUD_NC(baud, div) / 2) / ((div) * UART_BAUD_NC(baud, div)))
+#define UART_BAUD_ERR_DIV(baud, div)    ((UART_BAUD_ACT(baud, div) > (baud) ? UART_BAUD_ACT(baud, div) - (baud) \
+                                                                             : (baud) - UART_BAUD_ACT(baud, div)) * 10000ULL / (baud))
+#define UART_BAUD_ERR_CONST(baud)       (UART_BAUD_ERR_DIV(baud, 16ULL) < UART_BAUD_ERR_DIV(baud, 8ULL) ? \
+                                         UART_BAUD_ERR_DIV(baud, 16ULL) : UART_BAUD_ERR_DIV(baud, 8ULL))
+
+
+/* -------------------------------------------------------------------------- */
+/*                                UART CHANNEL                                */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    UART_CH0 = 0,        // USART0 (PE0 RXD0 / PE1 TXD0) : host link, 로그
+    UART_CH1,            // USART1 (PD2 RXD1 / PD3 TXD1) : GPS, modem 등 주변장치
+
+    UART_MAX_CH          // 채널 개수 (항상 마지막에 위치)
+} uart_ch_t;
+
+
 /* -------------------------------------------------------------------------- */
 /*                                API PROTOTYPES                              */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief  Open UART channel (8N1, RX/TX interrupt-driven)
+ *         normal / double speed(U2X) 중 오차가 작은 모드와
+ *         반올림된 UBRR을 자동 선택한다. (16MHz: 250k/500k/1M/2M 오차 0%)
+ *
+ * @param  ch   UART_CH0 / UART_CH1
+ * @param  baud Baudrate (ex: 38400, 500000)
+ * @return true  : 오차 ≤ UART_BAUD_ERR_MAX
+ *         false : 오차 초과 또는 잘못된 채널 (가장 가까운 설정은 적용됨)
+ */
+bool uartOpen(uart_ch_t ch, uint32_t baud);
+
+/**
+ * @brief  Queue one byte (TX 버퍼가 가득 차면 대기)
+ */
+void uartWriteCh(uart_ch_t ch, char c);
+
+/**
+ * @brief  Queue buffer
+ */
+void uartWriteBuf(uart_ch_t ch, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief  Queue null-terminated string
+ */
+void uartPrintCh(uart_ch_t ch, const char *str);
 
 /**
- * @brief Initialize UART0 with given baudrate.
+ * @brief  Wait until all queued TX bytes are physically sent
+ *         (리셋/슬립/부트로더 점프 전 호출)
+ */
+void uartFlush(uart_ch_t ch);
+
+/**
+ * @brief  Number of received bytes waiting in RX buffer
+ */
+uint32_t uartAvailable(uart_ch_t ch);
+
+/**
+ * @brief  Read one received byte
+ * @return 수신 바이트 (비어 있으면 0, uartAvailable()로 먼저 확인)
+ */
+uint8_t uartRead(uart_ch_t ch);
+
+/**
+ * @brief  Bytes dropped because RX buffer was full
+ */
+uint16_t uartGetRxOverflow(uart_ch_t ch);
+
+/**
+ * @brief  Actual baudrate of channel [bps]
+ */
+uint32_t uartGetBaudCh(uart_ch_t ch);
+
+/**
+ * @brief  Baudrate error of channel
+ * @return (actual - requested) / requested [0.01%] (예: -79 = -0.79%)
+ */
+int16_t uartGetBaudErrCh(uart_ch_t ch);
+
+
+/* -------------------------------------------------------------------------- */
+/*                         USART0 WRAPPER (LEGACY API)                        */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Initialize UART0 with given baudrate. (= uartOpen(UART_CH0, baud))
  *
- * @param baud Baudrate (ex: 38400, 9600)
+ * @param baud Baudrate (ex: 38400, 500000)
+ * @return true  : 오차 ≤ UART_BAUD_ERR_MAX
+ *         false : 오차 초과 (가장 가까운 설정은 적용됨, uartGetBaudErr()로 확인)
  */
-void uartInit(uint32_t baud);
+bool uartInit(uint32_t baud);
 
 /**
  * @brief Transmit one character
@@ -35,4 +140,39 @@ void uartWrite(char c);
  */
 void uartPrint(const char *str);
 
+/**
+ * @brief  Actual baudrate of UART0
+ */
+uint32_t uartGetBaud(void);
+
+/**
+ * @brief  Baudrate error of UART0 [0.01%]
+ */
+int16_t uartGetBaudErr(void);
+
+
+#if (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                              HOST-ONLY CONTROL                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Redirect channel output to file descriptor
+ *         (기본: CH0 = stdout, CH1 = 버림(-1), 테스트는 pipe)
+ */
+void uartHostSetFd(uart_ch_t ch, int fd);
+
+/**
+ * @brief  Push bytes into channel RX buffer (수신 시뮬레이션)
+ */
+void uartHostInject(uart_ch_t ch, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief  Create pseudo terminal for channel (입출력 모두 pty 사용)
+ * @param  name 생성된 slave 경로 (예: /dev/pts/3) 저장 버퍼
+ * @param  len  name 버퍼 크기
+ * @return true = 성공
+ */
+bool uartHostOpenPty(uart_ch_t ch, char *name, size_t len);
+#endif
+
 #endif /* UART_H_ */
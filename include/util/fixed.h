@@ -0,0 +1,227 @@
+/*
+ * File: fixed.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Fixed-point arithmetic / DSP / control library (8bit AVR 용)
+ *              - Q15  (int16, -1.0 ~ 0.99997, LSB 2^-15)
+ *              - Q7.8 (int16, -128.0 ~ 127.996, LSB 2^-8)
+ *              - 포화 연산, 이동평균, 1차 IIR, biquad, PID(anti-windup), LUT 선형보간
+ *
+ * 비용/오차
+ *   cycle : ATmega128 -Os 명령어 수 기준 추정치 (미측정).
+ *           행 이름 = env:bench 항목 이름 (bench.c bench_tbl, 1:1) → 실측 후 이 열을 교체.
+ *   오차  : 같은 양자화 계수를 쓴 double 연산 대비 한계, test/test_fixed 에서 검사.
+ *
+ *   bench 항목        cycle(추정)   오차
+ *   q15Mul            약   40       ≤ 0.5 LSB (반올림)
+ *   q78Mul            약   40       ≤ 0.5 LSB (반올림)
+ *   q78Div            약  600       ≤ 0.5 LSB
+ *   fixMaUpdate       약   70       ≤ 0.5 LSB (정확한 합, 반올림 1회)
+ *   fixIirUpdate      약  110       < 1 LSB   (잔차 누적 → deadband 없음, alpha 0.001 에서 0.97)
+ *   fixBiquadUpdate   약  200       < 2 LSB   (잔차 피드백, Butterworth LP fc = fs/20 에서 1.46)
+ *   fixPidUpdate      약  250       ≤ 0.5 LSB (출력 포화 전 구간)
+ *   fixLutInterp      약   80       ≤ 0.5 LSB (테이블 점 사이 직선 대비)
+ *   floatMul          약  100~150   (float 기준, 곱셈 1회)
+ *   floatBiquad       약 1500       (float 기준, 같은 계수)
+ *   → 1kHz 제어 루프(fixBiquadUpdate + fixPidUpdate) 추정 약 450 cycle = 1ms 의 약 3%.
+ */
+
+#ifndef FIXED_H_
+#define FIXED_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                              */
+/* -------------------------------------------------------------------------- */
+typedef int16_t q15_t;      // Q15  : 1 sign + 15 frac
+typedef int16_t q7_8_t;     // Q7.8 : 1 sign + 7 int + 8 frac
+typedef int16_t q14_t;      // Q1.14: biquad 계수 (-2.0 ~ 1.99994)
+
+#define Q15_MAX     INT16_MAX
+#define Q15_MIN     INT16_MIN
+#define Q7_8_ONE    256
+
+/* 실수 상수 → 고정소수점 (컴파일 타임 전용, 범위 밖은 포화) */
+#define FIX_CONST(x, frac_bits, lo, hi) \
+    ((int16_t)(((x) * (double)(1L << (frac_bits))) >= (hi) ? (hi) : \
+               ((x) * (double)(1L << (frac_bits))) <= (lo) ? (lo) : \
+               ((x) * (double)(1L << (frac_bits))) + ((x) >= 0 ? 0.5 : -0.5)))
+
+#define Q15(x)      FIX_CONST(x, 15, INT16_MIN, INT16_MAX)
+#define Q7_8(x)     FIX_CONST(x,  8, INT16_MIN, INT16_MAX)
+#define Q14(x)      FIX_CONST(x, 14, INT16_MIN, INT16_MAX)
+
+
+/* -------------------------------------------------------------------------- */
+/*                           SATURATING ARITHMETIC                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  int32 → int16 saturate
+ */
+static inline int16_t fixSat16(int32_t x)
+{
+    if (x > INT16_MAX) return INT16_MAX;
+    if (x < INT16_MIN) return INT16_MIN;
+    return (int16_t)x;
+}
+
+/**
+ * @brief  int32 + int32 saturate
+ */
+static inline int32_t fixSatAdd32(int32_t a, int32_t b)
+{
+    int32_t s = (int32_t)((uint32_t)a + (uint32_t)b);
+
+    // 부호가 같은 두 수의 합의 부호가 바뀌면 overflow
+    if (((a ^ s) & (b ^ s)) < 0)
+        return (a < 0) ? INT32_MIN : INT32_MAX;
+    return s;
+}
+
+static inline q15_t q15Add(q15_t a, q15_t b)    { return fixSat16((int32_t)a + b); }
+static inline q15_t q15Sub(q15_t a, q15_t b)    { return fixSat16((int32_t)a - b); }
+static inline q15_t q15Neg(q15_t a)             { return fixSat16(-(int32_t)a); }
+static inline q15_t q15Abs(q15_t a)             { return (a < 0) ? q15Neg(a) : a; }
+
+/**
+ * @brief  Q15 × Q15 → Q15 (반올림, -1 × -1 은 Q15_MAX 로 포화)
+ */
+static inline q15_t q15Mul(q15_t a, q15_t b)
+{
+    return fixSat16(((int32_t)a * b + (1L << 14)) >> 15);
+}
+
+static inline q7_8_t q78Add(q7_8_t a, q7_8_t b) { return fixSat16((int32_t)a + b); }
+static inline q7_8_t q78Sub(q7_8_t a, q7_8_t b) { return fixSat16((int32_t)a - b); }
+
+/**
+ * @brief  Q7.8 × Q7.8 → Q7.8 (반올림, 포화)
+ */
+static inline q7_8_t q78Mul(q7_8_t a, q7_8_t b)
+{
+    return fixSat16(((int32_t)a * b + (1L << 7)) >> 8);
+}
+
+/**
+ * @brief  Q7.8 ÷ Q7.8 → Q7.8 (0 나눗셈 = 포화, 32/32bit 나눗셈 약 600 cycle)
+ */
+q7_8_t q78Div(q7_8_t a, q7_8_t b);
+
+/**
+ * @brief  int → Q7.8 (포화) / Q7.8 → int (반올림)
+ */
+static inline q7_8_t q78FromInt(int16_t i)      { return fixSat16((int32_t)i << 8); }
+static inline int16_t q78ToInt(q7_8_t a)        { return (int16_t)(((int32_t)a + 128) >> 8); }
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   FILTERS                                   */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Moving average (창 크기 = 2^shift, 버퍼는 호출자 제공)
+ */
+typedef struct
+{
+    int16_t *buf;       // 2^shift 개
+    int32_t  sum;       // 창 내 합 (정확)
+    uint8_t  shift;     // log2(창 크기)
+    uint8_t  idx;       // 다음 기록 위치
+} fix_ma_t;
+
+/**
+ * @brief  1st-order IIR low-pass: y += alpha × (x - y)
+ *         alpha = 1 - exp(-2π·fc/fs) (Q15), 잘린 소수부는 frac 에 누적.
+ */
+typedef struct
+{
+    q15_t   alpha;
+    int16_t y;          // 출력
+    int16_t frac;       // 잘린 소수부 잔차 (Q15)
+} fix_iir_t;
+
+/**
+ * @brief  Biquad (Direct Form I)
+ *         y = b0·x + b1·x1 + b2·x2 - a1·y1 - a2·y2   (계수 Q14, a0 = 1 정규화)
+ *         누적은 int32, 잘린 하위 bit 는 다음 샘플에 더함 (1차 error feedback).
+ * @note   |b0|+|b1|+|b2|+|a1|+|a2| < 4 이면 누적 overflow 없음.
+ */
+typedef struct
+{
+    q14_t   b0, b1, b2;
+    q14_t   a1, a2;
+    int16_t x1, x2;     // 입력 지연
+    int16_t y1, y2;     // 출력 지연
+    int16_t err;        // 양자화 잔차 (Q14)
+} fix_biquad_t;
+
+/**
+ * @brief  PID (derivative on measurement, conditional integration anti-windup)
+ *         이득 Q7.8, 입출력은 같은 정수 단위 (예: ADC count → PWM duty).
+ */
+typedef struct
+{
+    q7_8_t  kp, ki, kd;     // ki, kd 는 샘플 주기 반영값 (ki = Ki·T, kd = Kd/T)
+    int16_t out_min;
+    int16_t out_max;
+    int32_t integ;          // 적분 상태 (Q8), [out_min, out_max] 로 제한
+    int16_t prev_pv;        // 직전 측정값
+    bool    first;          // 첫 호출 (미분항 0)
+} fix_pid_t;
+
+/**
+ * @brief  Lookup table, 균등 간격 x0 + i·2^shift
+ */
+typedef struct
+{
+    const int16_t *y;       // n 개 값
+    uint8_t        n;       // 점 개수 (≥ 2)
+    uint8_t        shift;   // log2(간격), 0 ~ 15
+    int16_t        x0;      // 첫 점 x
+} fix_lut_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                               */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Init moving average (버퍼를 init 값으로 채움)
+ * @param  buf   2^shift 개 int16 버퍼
+ * @param  shift 0 ~ 7 (창 1 ~ 128)
+ */
+void fixMaInit(fix_ma_t *p_ma, int16_t *buf, uint8_t shift, int16_t init);
+int16_t fixMaUpdate(fix_ma_t *p_ma, int16_t x);
+
+void fixIirInit(fix_iir_t *p_iir, q15_t alpha, int16_t init);
+int16_t fixIirUpdate(fix_iir_t *p_iir, int16_t x);
+
+/**
+ * @brief  Init biquad (계수는 Q14() 매크로로 생성, 지연선 0)
+ */
+void fixBiquadInit(fix_biquad_t *p_bq, q14_t b0, q14_t b1, q14_t b2, q14_t a1, q14_t a2);
+int16_t fixBiquadUpdate(fix_biquad_t *p_bq, int16_t x);
+
+void fixPidInit(fix_pid_t *p_pid, q7_8_t kp, q7_8_t ki, q7_8_t kd, int16_t out_min, int16_t out_max);
+
+/**
+ * @brief  Reset PID state (적분 0, 미분 기준 초기화)
+ */
+void fixPidReset(fix_pid_t *p_pid);
+
+/**
+ * @brief  One PID step
+ * @param  sp 목표값
+ * @param  pv 측정값
+ * @return 제어 출력 [out_min, out_max]
+ */
+int16_t fixPidUpdate(fix_pid_t *p_pid, int16_t sp, int16_t pv);
+
+/**
+ * @brief  Linear interpolation (범위 밖은 양 끝 값으로 clamp)
+ */
+int16_t fixLutInterp(const fix_lut_t *p_lut, int16_t x);
+
+#endif /* FIXED_H_ */
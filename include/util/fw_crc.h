@@ -0,0 +1,96 @@
+/*
+ * File: fw_crc.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Background firmware image integrity check (CRC-32)
+ *              flash 프로그램 이미지를 idle 시간에 작은 조각(slice)으로 나눠
+ *              CRC-32 (IEEE, zlib 호환)를 계산하고, 빌드 시 tools/fw_crc.py 가
+ *              이미지에 기록한 기준값과 비교한다.
+ *
+ * 기준값: fw_crc_info {magic, len, crc} (flash, PROGMEM)
+ *         빌드 후 스크립트가 len/crc 를 채움 (이 8byte 는 CRC 계산에서 제외).
+ *         스크립트 없이 빌드된 이미지는 FW_CRC_NO_REF.
+ */
+
+#ifndef FW_CRC_H_
+#define FW_CRC_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                FW CRC CONFIG                                */
+/* -------------------------------------------------------------------------- */
+#ifndef FW_CRC_SLICE_CYCLES
+#define FW_CRC_SLICE_CYCLES     4000    // slice 1회 최대 cycle (16MHz: 250µs)
+#endif
+
+#ifndef FW_CRC_CHECK_BYTES
+#define FW_CRC_CHECK_BYTES      16      // slice 중 경과 시간(micros) 확인 간격 [byte]
+#endif
+
+#ifndef FW_CRC_SLICE_MAX_BYTES
+#define FW_CRC_SLICE_MAX_BYTES  1024    // slice 1회 최대 byte (시계 정지 시 안전 상한)
+#endif
+
+#ifndef FW_CRC_PASS_INTERVAL_MS
+#define FW_CRC_PASS_INTERVAL_MS 10000   // pass 완료 후 다음 pass 시작까지 대기
+#endif
+
+#define FW_CRC_SLICE_US         (FW_CRC_SLICE_CYCLES / (F_CPU / 1000000UL))
+
+#define FW_CRC_MAGIC            0x43524346UL    // "FCRC" (tools/fw_crc.py 와 일치)
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                              */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    FW_CRC_PENDING = 0,  // 첫 pass 진행 중
+    FW_CRC_OK,           // 마지막 pass 일치
+    FW_CRC_FAIL,         // 마지막 pass 불일치 (flash 손상)
+    FW_CRC_NO_REF        // 기준값 없음 (post-build 스크립트 미적용 / 미지원 backend)
+} fw_crc_status_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                               */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Read embedded reference and start first pass
+ * @return false = 기준값 없음 (FW_CRC_NO_REF, fwCrcStep() 은 아무것도 안 함)
+ */
+bool fwCrcInit(void);
+
+/**
+ * @brief  Process one slice (실행 시간 ≤ FW_CRC_SLICE_US, micros() 로 제한)
+ *         idle 시간이 FW_CRC_SLICE_US 이상 남았을 때만 호출.
+ *         byte 당 cycle 추정값에 의존하지 않음. 초과 가능량은 micros() 분해능(4µs) 정도.
+ * @return true = 계산 수행, false = pass 간 대기 중 또는 비활성
+ */
+bool fwCrcStep(void);
+
+/**
+ * @brief  Result of last completed pass
+ */
+fw_crc_status_t fwCrcGetStatus(void);
+
+/**
+ * @brief  CRC-32 computed by last completed pass
+ */
+uint32_t fwCrcGetValue(void);
+
+/**
+ * @brief  Wall time of last completed pass [ms]
+ */
+uint32_t fwCrcGetPassMs(void);
+
+/**
+ * @brief  Number of completed passes
+ */
+uint16_t fwCrcGetPassCount(void);
+
+#endif /* FW_CRC_H_ */
@@ -0,0 +1,170 @@
+/*
+ * File: trace.h
+ * Author: Young Kwan CHO, Lilith
+ * Description: Low-overhead timestamped event trace
+ *              (event ID, timestamp) 쌍을 RAM 링버퍼에 기록하고
+ *              요청 시 UART로 바이너리 덤프한다.
+ *              호스트 변환기: tools/trace2json.py → Chrome trace / Perfetto
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+#include "delay.h"   // g_ms (1ms tick counter)
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 TRACE CONFIG                                */
+/* -------------------------------------------------------------------------- */
+#ifndef TRACE_BUF_SIZE
+#define TRACE_BUF_SIZE      128     // 이벤트 개수 (2의 거듭제곱, 최대 256)
+#endif
+#define TRACE_BUF_MASK      (TRACE_BUF_SIZE - 1)
+
+#if (TRACE_BUF_SIZE & TRACE_BUF_MASK) || (TRACE_BUF_SIZE > 256)
+#error "TRACE_BUF_SIZE must be a power of 2 and <= 256"
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  EVENT ID                                   */
+/* -------------------------------------------------------------------------- */
+/*
+ * id[7:6] : phase  (00 = enter, 10 = exit, 01 = instant)
+ * id[5:0] : event code
+ * 코드 맵은 tools/trace2json.py 의 이름 테이블과 일치해야 함.
+ */
+#define TRACE_PH_ENTER          0x00
+#define TRACE_PH_EXIT           0x80
+#define TRACE_PH_MARK           0x40
+#define TRACE_CODE_MASK         0x3F
+
+#define TRACE_EVT_TASK(n)       (0x00 + (n))    // appTask() APP_TASK_MAP n번째 (0x00~0x0F)
+#define TRACE_EVT_ISR_TICK      0x10            // TIMER1_COMPA_vect
+#define TRACE_EVT_UART_TX       0x20            // uartPrint()
+#define TRACE_EVT_USER(n)       (0x28 + (n))    // 애플리케이션 정의 (0x28~0x3F)
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                              */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Trace record (4 bytes → index * 4 는 shift 2회)
+ *         timestamp[us] = ms * 1000 + tick * 4
+ *         id == TRACE_ID_EMPTY 인 슬롯은 미기록 (traceInit 에서 채움)
+ */
+typedef struct
+{
+    uint8_t  id;        // phase | code
+    uint16_t ms;        // g_ms 하위 16bit (65.5s 주기 wrap, 미처리 tick 보정 포함)
+    uint8_t  tick;      // TCNT1 하위 byte (4µs 단위, 0~249 = OCR1A)
+} trace_evt_t;
+
+#define TRACE_ID_EMPTY          0xFF    // phase 11 = 미사용 → 빈 슬롯 표시
+
+
+/* -------------------------------------------------------------------------- */
+/*                                RECORD (INLINE)                              */
+/* -------------------------------------------------------------------------- */
+extern trace_evt_t      trace_buf[TRACE_BUF_SIZE];
+extern volatile uint8_t trace_head;
+extern volatile bool    trace_enabled;
+
+/**
+ * @brief  Record one event (ISR / main 어디서나 호출 가능)
+ *
+ * @note   ATmega128 -Os 명령어 열 기준 약 35 cycle (simavr 미측정,
+ *         env:bench 의 traceRecord 항목으로 확인).
+ *         SREG/cli 3 + enable 검사 4 + slot 주소 8 + store 4개 8 + g_ms/TCNT1 load 5
+ *         + OCF1A 보정 약 5 + head 갱신 4 → 20 cycle 이하는 ms(16bit) + tick 타임스탬프와
+ *         cli 보호를 유지하는 한 불가 (load/store 만 약 20 cycle).
+ *         - wrap 플래그 없음: 빈 슬롯은 TRACE_ID_EMPTY 로 구분 (traceDump)
+ *         - tick 은 TCNT1L 만 읽음 (TOP 249 < 256)
+ *         - TCNT1 이 TOP 을 지났지만 tick ISR 이 아직 g_ms 를 올리지 못한 경우
+ *           (ISR 내부 / cli 구간 기록) micros() 와 같은 OCF1A 보정으로 ms + 1
+ *           → 기록 값이 그대로 정확, 호스트 추정 보정 없음
+ *         - micros() 변환(32bit 곱셈) 없이 raw 값만 저장, µs 변환은 호스트에서 수행.
+ */
+static inline void traceRecord(uint8_t id)
+{
+#if (MCU_TYPE == MCU_ATMEGA128)
+    uint8_t sreg = SREG;
+
+    cli();
+    if (trace_enabled)
+    {
+        trace_evt_t *p    = &trace_buf[trace_head];
+        uint16_t     ms   = (uint16_t)g_ms;
+        uint8_t      tick = TCNT1L;
+
+        if ((TIFR & (1 << OCF1A)) && (tick < 125))
+            ms++;
+
+        p->id   = id;
+        p->ms   = ms;
+        p->tick = tick;
+        trace_head = (trace_head + 1) & TRACE_BUF_MASK;
+    }
+    SREG = sreg;
+#else
+    if (trace_enabled)
+    {
+        uint32_t     us = micros();
+        trace_evt_t *p  = &trace_buf[trace_head];
+
+        p->id   = id;
+        p->ms   = (uint16_t)(us / 1000UL);
+        p->tick = (uint8_t)((us % 1000UL) / 4UL);
+        trace_head = (trace_head + 1) & TRACE_BUF_MASK;
+    }
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                TRACE MACROS                                 */
+/* -------------------------------------------------------------------------- */
+/* _USE_TRACE 미정의 시 모든 계측 코드는 컴파일되지 않음 (오버헤드 0)
+ * TRACE_EVT_ISR_TICK 은 _USE_TRACE_TICK 추가 정의 시에만 기록
+ * (1ms 마다 2 event → 기본 128개 버퍼가 약 64ms 의 tick 으로 채워짐) */
+#ifdef _USE_TRACE
+#define TRACE_ENTER(code)   traceRecord(TRACE_PH_ENTER | (code))
+#define TRACE_EXIT(code)    traceRecord(TRACE_PH_EXIT  | (code))
+#define TRACE_MARK(code)    traceRecord(TRACE_PH_MARK  | (code))
+#else
+#define TRACE_ENTER(code)   ((void)0)
+#define TRACE_EXIT(code)    ((void)0)
+#define TRACE_MARK(code)    ((void)0)
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/*                                API PROTOTYPES                               */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Clear buffer and start recording
+ */
+void traceInit(void);
+
+/**
+ * @brief  Enable / disable recording
+ * @param  enable true = 기록, false = 정지 (버퍼 유지)
+ */
+void traceEnable(bool enable);
+
+/**
+ * @brief  Dump buffered events over UART (binary) and clear buffer
+ *
+ * Format (little-endian):
+ *   "TRC2" | count(u16) | tick_us(u8) | record[count] (id u8, ms u16, tick u8)
+ *   record는 오래된 순서로 출력된다 (빈 슬롯 제외).
+ *
+ * @note   덤프 중에는 기록이 정지되며, 덤프 후 원래 상태로 복귀한다.
+ */
+void traceDump(void);
+
+#endif /* TRACE_H_ */
@@ -11,42 +11,50 @@
 /*                                INCLUDE FILES                               */
 /* -------------------------------------------------------------------------- */
 #include "app.h"
+#include "app_config.h" // APP_TASK_MAP, APP_UART_BAUD
 #include "gpio.h"   // GPIO HAL
 #include "uart.h"   // UART HAL 추가 시 활성화
 #include "delay.h"  // TIMER 기반 delay 사용 시 활성화
+#include "trace.h"  // 이벤트 트레이스 (_USE_TRACE)
+#include "lcd.h"    // HD44780 LCD (framebuffer, non-blocking)
+#include "onewire.h" // 1-Wire DS18B20 (Timer0)
+#include "fw_crc.h" // flash 이미지 CRC (idle 시간)
+#include "keypad.h" // key matrix (1ms 행 scan)
 #undef millis
 
 
-/* -------------------------------------------------------------------------- */
-/*                                 TASK TYPES                                 */
-/* -------------------------------------------------------------------------- */
-typedef struct
-{
-    void (*handler)(void);     // Task 함수
-    uint32_t period_ms;        // 주기
-    uint32_t last_tick;        // 최근 실행 tick
-} task_t;
-
 /* -------------------------------------------------------------------------- */
 /*                             TASK PROTOTYPES                                */
 /* -------------------------------------------------------------------------- */
-static void task_1ms(void);
-static void task_50ms(void);
-static void task_100ms(void);
-static void task_500ms(void);
+#define APP_X_TASK_PROTO(fn, period)    static void fn(void);
+APP_TASK_MAP(APP_X_TASK_PROTO)
+#undef APP_X_TASK_PROTO
 
 /* -------------------------------------------------------------------------- */
 /*                                TASK TABLE                                  */
 /* -------------------------------------------------------------------------- */
-#define TASK_MAX 4
-
-static task_t task_tbl[TASK_MAX] =
+/* app_config.h APP_TASK_MAP 에서 생성: 주기는 코드 안의 상수(flash), RAM 은 최근 실행 tick 만 */
+typedef enum
 {
-    { task_1ms,     1,   0 },
-    { task_50ms,   50,   0 },
-    { task_100ms, 100,   0 },
-    { task_500ms, 500,   0 },
-};
+#define APP_X_TASK_ID(fn, period)       TASK_ID_##fn,
+    APP_TASK_MAP(APP_X_TASK_ID)
+#undef APP_X_TASK_ID
+
+    TASK_MAX             // task 개수 (항상 마지막에 위치)
+} task_id_t;
+
+#define APP_X_TASK_CHECK(fn, period) \
+    _Static_assert((period) >= 1 && (period) <= 60000UL, #fn ": period must be 1 ~ 60000 ms");
+APP_TASK_MAP(APP_X_TASK_CHECK)
+#undef APP_X_TASK_CHECK
+
+_Static_assert(TASK_MAX <= 16, "TASK_MAX exceeds TRACE_EVT_TASK range (0x00 ~ 0x0F)");
+_Static_assert(UART_BAUD_ERR_CONST(APP_UART_BAUD) <= UART_BAUD_ERR_MAX,
+               "APP_UART_BAUD: baud error exceeds UART_BAUD_ERR_MAX");
+
+#define APP_IDLE_MARGIN_US  50     // idle slice 중 ISR 실행 여유
+
+static uint32_t task_last[TASK_MAX];   // task 별 최근 실행 tick
 
 /* -------------------------------------------------------------------------- */
 /*                              APP INITIALIZE                                */
@@ -59,7 +67,18 @@ void appInit(void)
 {
     gpioInit();            // 논리 GPIO 초기화
     delayInit();        // TIMER 기반 delay 사용 시 활성화
-    uartInit(38400);         // UART 사용 시 
+    for (uint8_t i = 0; i < TASK_MAX; i++)
+        task_last[i] = 0;  // 재초기화 시에도 모든 task 주기를 0ms 기준으로 (host 테스트)
+    uartInit(APP_UART_BAUD);   // UART (normal/U2X 자동 선택, 오차는 컴파일 타임 검사)
+#ifdef _USE_TRACE
+    traceInit();           // 이벤트 트레이스 시작
+#endif
+    lcdInit();             // LCD 초기화 예약 (실제 전송은 task_1ms)
+    lcdPrintAt(0, 0, "APP INIT OK");
+    if (onewireInit())     // 1-Wire 버스 (Timer0)
+        onewireQueueSearch();
+    fwCrcInit();           // flash CRC 기준값 확인, 첫 pass 시작
+    keypadInit();          // key matrix 첫 행 구동
 
     
     uartPrint("APP INIT OK\r\n");  
@@ -68,6 +87,21 @@ void appInit(void)
 /* -------------------------------------------------------------------------- */
 /*                                TASK EXECUTOR                               */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief One task check (id/handler/period 상수 → 호출부에 전개)
+ */
+static inline __attribute__((always_inline)) void appTaskRun(uint8_t id, void (*handler)(void),
+                                                             uint32_t period_ms, uint32_t now)
+{
+    if (now - task_last[id] >= period_ms)
+    {
+        task_last[id] = now;
+        TRACE_ENTER(TRACE_EVT_TASK(id));
+        handler();
+        TRACE_EXIT(TRACE_EVT_TASK(id));
+    }
+}
+
 /**
  * @brief Task dispatcher
  *        main() 또는 scheduler에서 반복 호출되어야 함
@@ -76,14 +110,50 @@ void appTask(void)
 {
     uint32_t now = millis();
 
-    for (uint8_t i = 0; i < TASK_MAX; i++)
-    {
-        if (now - task_tbl[i].last_tick >= task_tbl[i].period_ms)
-        {
-            task_tbl[i].last_tick = now;
-            task_tbl[i].handler();
-        }
-    }
+#define APP_X_TASK_RUN(fn, period)      appTaskRun(TASK_ID_##fn, fn, (period), now);
+    APP_TASK_MAP(APP_X_TASK_RUN)
+#undef APP_X_TASK_RUN
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                  APP IDLE                                  */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief Remaining ms until task deadline → *p_slack 최소값 갱신
+ * @return false = 지금 실행할 task 있음
+ */
+static inline __attribute__((always_inline)) bool appTaskSlack(uint8_t id, uint32_t period_ms,
+                                                               uint32_t now, uint32_t *p_slack)
+{
+    uint32_t elapsed = now - task_last[id];
+
+    if (elapsed >= period_ms) return false;
+
+    if (period_ms - elapsed < *p_slack)
+        *p_slack = period_ms - elapsed;
+    return true;
+}
+
+/**
+ * @brief Background work between task deadlines
+ *        가장 가까운 task 마감까지 남은 시간이 slice 최대 시간보다 길 때만
+ *        slice 1회 실행 → task 가 마감을 넘기지 않음.
+ */
+static void appIdle(void)
+{
+    uint32_t now   = millis();
+    uint32_t slack = UINT32_MAX;   // 가장 가까운 마감까지 남은 ms
+    int32_t  remain_us;
+
+#define APP_X_TASK_SLACK(fn, period)    if (!appTaskSlack(TASK_ID_##fn, (period), now, &slack)) return;
+    APP_TASK_MAP(APP_X_TASK_SLACK)
+#undef APP_X_TASK_SLACK
+
+    // 마감은 ms 경계 → 남은 µs = 마감 시각 - micros()
+    remain_us = (int32_t)(((now + slack) * 1000UL) - micros());
+    if (remain_us < (int32_t)(FW_CRC_SLICE_US + APP_IDLE_MARGIN_US)) return;
+
+    fwCrcStep();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -100,6 +170,7 @@ void appMain(void)
       while (1)
   {
     appTask();             // Task 처리 
+    appIdle();             // 남는 시간: flash CRC slice
   }
 
     // NOTE:
@@ -115,7 +186,9 @@ void appMain(void)
  */
 static void task_1ms(void)
 {
-    // TODO: KEY SCAN, debounce 등
+    lcdUpdate();           // 변경된 LCD 셀 1바이트 전송
+    onewireUpdate();       // 1-Wire 동작 완료 처리 / 다음 동작 시작
+    keypadScan();          // key matrix 1행 scan + debounce
 }
 
 /**
@@ -123,7 +196,18 @@ static void task_1ms(void)
  */
 static void task_50ms(void)
 {
-    // TODO: Sys status check
+    keypad_evt_t evt;
+
+    while (keypadRead(&evt))   // 눌린 key 번호 LCD 2행 표시
+    {
+        char msg[] = "KEY 00";
+
+        if (!evt.pressed) continue;
+
+        msg[4] = (char)('0' + evt.key / 10);
+        msg[5] = (char)('0' + evt.key % 10);
+        lcdPrintAt(0, 1, msg);
+    }
 }
 
 /**
@@ -140,4 +224,7 @@ static void task_100ms(void)
 static void task_500ms(void)
 {
     gpioToggle(GPIO_LED);  // LED 토글
+
+    if (!onewireIsBusy())  // 이전 측정 완료 시 전체 센서 변환 + 읽기 예약
+        onewireQueueReadAll();
 }
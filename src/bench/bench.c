@@ -0,0 +1,410 @@
+/*
+ * File: bench.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: HAL / scheduler hot-path benchmark firmware (env:bench, env:native_bench)
+ *              각 함수를 단독 호출하여 호출당 비용을 측정하고 UART로 출력한다.
+ *              ATmega128 : Timer3 (prescaler 1) → CPU cycle 단위
+ *              MCU_HOST  : CLOCK_MONOTONIC     → ns 단위 (BENCH_HOST_LOOP 회 평균)
+ *              결과 수집/베이스라인 비교: tools/bench.py
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "app.h"
+#include "gpio.h"
+#include "uart.h"
+#include "delay.h"
+#include "soft_timer.h"
+#include "lcd.h"
+#include "fixed.h"
+#include "fw_crc.h"
+#include "keypad.h"
+#include "trace.h"
+#include "pwm.h"
+#include "capture.h"
+
+#ifndef _BENCH
+#error "bench.c 는 -D_BENCH 로 빌드 (platformio.ini env:bench / env:native_bench)"
+#endif
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+#include <avr/sleep.h>
+#elif (MCU_TYPE == MCU_HOST)
+#include <time.h>
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+/*                                BENCH CONFIG                                */
+/* -------------------------------------------------------------------------- */
+#define BENCH_REPEAT        64      // 항목당 측정 횟수 (min/max 산출)
+#define BENCH_HOST_LOOP     10000   // host: 1회 측정당 반복 호출 수
+
+
+/* -------------------------------------------------------------------------- */
+/*                                BENCH CASES                                 */
+/* -------------------------------------------------------------------------- */
+/* sym 은 tools/bench.py 가 코드 크기를 조회하는 심볼명 (avr-nm), 없으면 bench.py 오류 */
+typedef struct
+{
+    const char *name;          // 항목 이름 (베이스라인 key)
+    const char *sym;           // 크기 조회 심볼 (inline 함수는 wrapper, ISR 은 __vector_N)
+    void (*fn)(void);          // 1회 호출 wrapper
+    void (*prep)(void);        // 매 측정 전 상태 준비 (측정 제외, NULL = 없음)
+} bench_t;
+
+#define BENCH_STR_(x)       #x
+#define BENCH_VECTOR(v)     BENCH_STR_(v)      // TIMER2_OVF_vect → "__vector_10"
+
+static soft_timer_t bench_tmr;              // softTimerIsElapsedAndReset 대상
+static char         bench_frame[LCD_ROWS * LCD_COLS];   // lcdWriteFrame 대상
+
+/* fixed-point 대상 (입력은 volatile → 상수 접힘 방지) */
+static volatile int16_t bench_x = 1234;
+static int16_t          bench_ma_buf[16];
+static fix_ma_t         bench_ma;
+static fix_iir_t        bench_iir;
+static fix_biquad_t     bench_bq;
+static fix_pid_t        bench_pid;
+static const int16_t    bench_lut_y[] = { 0, 100, 400, 900, 1600, 2500, 3600, 4900, 6400 };
+static const fix_lut_t  bench_lut = { bench_lut_y, 9, 9, 0 };
+static volatile int16_t bench_y;
+
+/* float 기준 (fixed.h 표의 float 행, 같은 계수) */
+static volatile float   bench_xf = 1234.0f;
+static volatile float   bench_yf;
+static float            bench_fbq_x1, bench_fbq_x2, bench_fbq_y1, bench_fbq_y2;
+
+static void benchEmpty(void)        { }
+static void benchGpioWrite(void)    { gpioWrite(GPIO_LED, GPIO_HIGH); }
+static void benchGpioToggle(void)   { gpioToggle(GPIO_LED); }
+static void benchGpioRead(void)     { (void)gpioRead(GPIO_LED); }
+static void benchMillis(void)       { (void)millis(); }
+static void benchMicros(void)       { (void)micros(); }
+static void benchSoftTimer(void)    { (void)softTimerIsElapsedAndReset(&bench_tmr); }
+static void benchAppTask(void)      { appTask(); }
+static void benchUartWriteCh1(void) { uartWriteCh(UART_CH1, 'U'); }
+static void benchPrepTx1(void)      { uartFlush(UART_CH1); }
+static void benchLcdWriteFrame(void) { lcdWriteFrame(bench_frame); }
+static void benchQ15Mul(void)       { bench_y = q15Mul(bench_x, Q15(0.7071)); }
+static void benchQ78Mul(void)       { bench_y = q78Mul(bench_x, Q7_8(1.25)); }
+static void benchQ78Div(void)       { bench_y = q78Div(bench_x, Q7_8(3.3)); }
+static void benchFloatMul(void)     { bench_yf = bench_xf * 0.7071f; }
+static void benchMa(void)           { bench_y = fixMaUpdate(&bench_ma, bench_x); }
+static void benchIir(void)          { bench_y = fixIirUpdate(&bench_iir, bench_x); }
+static void benchBiquad(void)       { bench_y = fixBiquadUpdate(&bench_bq, bench_x); }
+static void benchPid(void)          { bench_y = fixPidUpdate(&bench_pid, 2000, bench_x); }
+static void benchLut(void)          { bench_y = fixLutInterp(&bench_lut, bench_x); }
+static void benchFwCrc(void)        { (void)fwCrcStep(); }
+static void benchKeypadScan(void)   { keypadScan(); }
+static void benchTraceRecord(void)  { traceRecord(TRACE_PH_MARK | TRACE_EVT_USER(0)); }
+
+static void benchFloatBiquad(void)
+{
+    float x = bench_xf;
+    float y = 0.0201f * x + 0.0402f * bench_fbq_x1 + 0.0201f * bench_fbq_x2
+            + 1.5610f * bench_fbq_y1 - 0.6414f * bench_fbq_y2;
+
+    bench_fbq_x2 = bench_fbq_x1;
+    bench_fbq_x1 = x;
+    bench_fbq_y2 = bench_fbq_y1;
+    bench_fbq_y1 = y;
+    bench_yf = y;
+}
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+/*
+ * UART 공용 코드(uart_hw_t + 채널 ctx) 비용 비교용 기준 구현.
+ * 같은 링버퍼 알고리즘을 USART0 레지스터/전역 변수로 직접 작성 (채널 인자 없음).
+ *   uartTxRef0  ↔ uartWriteCh0 / uartWriteCh1     : TX enqueue
+ *   uartRxRef0  ↔ USART0_RX_vect / USART1_RX_vect : RX ISR (prologue/epilogue 포함)
+ * ISR 은 직접 호출 (reti 로 I 가 켜지므로 max 에는 tick ISR 이 섞일 수 있음, min 비교).
+ */
+void USART0_RX_vect(void);
+void USART1_RX_vect(void);
+void __vector_bench_rx_ref(void) __attribute__((signal, used));   // signal: 실제 vector 와 같은 저장/복원
+
+static uint8_t          ref_tx_buf[UART_TX_BUF_SIZE];
+static volatile uint8_t ref_tx_head;
+static volatile uint8_t ref_tx_tail;
+static uint8_t          ref_rx_buf[UART_RX_BUF_SIZE];
+static volatile uint8_t ref_rx_head;
+static volatile uint8_t ref_rx_tail;
+static volatile uint16_t ref_rx_ovf;
+
+static void benchUartTxRef0(void)
+{
+    uint8_t next = (ref_tx_head + 1) & (UART_TX_BUF_SIZE - 1);
+    uint8_t sreg;
+
+    while (next == ref_tx_tail);        // prep 에서 비움 → 대기 없음
+
+    ref_tx_buf[ref_tx_head] = 'U';
+
+    sreg = SREG;
+    cli();
+    ref_tx_head = next;
+    UCSR0B |= (1 << UDRIE0);            // 실제 UDRE ISR 은 자기 링버퍼가 비어 있으면 곧바로 정지
+    SREG = sreg;
+}
+
+void __vector_bench_rx_ref(void)
+{
+    uint8_t status = UCSR0A;
+    uint8_t data   = UDR0;
+    uint8_t next;
+
+    if (status & ((1 << FE0) | (1 << UPE0))) return;
+
+    next = (ref_rx_head + 1) & (UART_RX_BUF_SIZE - 1);
+    if (next == ref_rx_tail)
+    {
+        ref_rx_ovf++;
+        return;
+    }
+    ref_rx_buf[ref_rx_head] = data;
+    ref_rx_head = next;
+}
+
+/* software PWM ISR: Timer2 정지 상태에서 직접 호출 (4채널/1포트, duty 모두 다름) */
+void TIMER2_OVF_vect(void);
+void TIMER2_COMP_vect(void);
+
+static void benchPwmOvf(void)       { TIMER2_OVF_vect(); }
+static void benchPwmComp(void)      { TIMER2_COMP_vect(); }
+static void benchPrepPwmComp(void)  { TIMER2_OVF_vect(); }     // 첫 엣지부터
+
+/* input capture ISR: 직접 호출 (ICR3 고정 → 상승 엣지 주기 기록 경로) */
+void TIMER3_CAPT_vect(void);
+
+static void benchCaptIsr(void)      { TIMER3_CAPT_vect(); }
+
+static void benchUartWriteCh0(void) { uartWriteCh(UART_CH0, 'U'); }
+static void benchUartRxRef0(void)   { __vector_bench_rx_ref(); }
+static void benchUartRx0(void)      { USART0_RX_vect(); }
+static void benchUartRx1(void)      { USART1_RX_vect(); }
+
+/* prep: 링버퍼를 비워 매번 같은 경로 (대기/overflow 없음) 측정 */
+static void benchPrepTxRef(void)    { ref_tx_head = ref_tx_tail = 0; }
+static void benchPrepTx0(void)      { uartFlush(UART_CH0); }
+static void benchPrepRxRef(void)    { ref_rx_head = ref_rx_tail = 0; }
+static void benchPrepRx0(void)      { while (uartAvailable(UART_CH0)) (void)uartRead(UART_CH0); }
+static void benchPrepRx1(void)      { while (uartAvailable(UART_CH1)) (void)uartRead(UART_CH1); }
+#endif
+
+static const bench_t bench_tbl[] =
+{
+    { "gpioWrite",                   "gpioWrite",                     benchGpioWrite,      NULL },
+    { "gpioToggle",                  "gpioToggle",                    benchGpioToggle,     NULL },
+    { "gpioRead",                    "gpioRead",                      benchGpioRead,       NULL },
+    { "millis",                      "millis",                        benchMillis,         NULL },
+    { "micros",                      "micros",                        benchMicros,         NULL },
+    { "softTimerIsElapsedAndReset",  "softTimerIsElapsedAndReset",    benchSoftTimer,      NULL },
+    { "appTask",                     "appTask",                       benchAppTask,        NULL },
+    { "uartWriteCh1",                "uartWriteCh",                   benchUartWriteCh1,   benchPrepTx1 },
+#if (MCU_TYPE == MCU_ATMEGA128)
+    { "uartTxRef0",                  "benchUartTxRef0",               benchUartTxRef0,     benchPrepTxRef },  // USART0 직접 (기준)
+    { "uartWriteCh0",                "uartWriteCh",                   benchUartWriteCh0,   benchPrepTx0 },
+    { "uartRxRef0",                  "__vector_bench_rx_ref",         benchUartRxRef0,     benchPrepRxRef },  // USART0 직접 (기준)
+    { "USART0_RX_vect",              BENCH_VECTOR(USART0_RX_vect),    benchUartRx0,        benchPrepRx0 },
+    { "USART1_RX_vect",              BENCH_VECTOR(USART1_RX_vect),    benchUartRx1,        benchPrepRx1 },
+    { "TIMER2_OVF_vect",             BENCH_VECTOR(TIMER2_OVF_vect),   benchPwmOvf,         NULL },            // software PWM 주기 시작
+    { "TIMER2_COMP_vect",            BENCH_VECTOR(TIMER2_COMP_vect),  benchPwmComp,        benchPrepPwmComp },// software PWM 엣지 1개
+    { "TIMER3_CAPT_vect",            BENCH_VECTOR(TIMER3_CAPT_vect),  benchCaptIsr,        NULL },            // CAPTURE_MODE_PERIOD
+#endif
+    { "lcdWriteFrame",               "lcdWriteFrame",                 benchLcdWriteFrame,  NULL },
+    /* fixed.h 비용 표와 1:1 (같은 이름) */
+    { "q15Mul",                      "benchQ15Mul",                   benchQ15Mul,         NULL },            // inline → wrapper 크기
+    { "q78Mul",                      "benchQ78Mul",                   benchQ78Mul,         NULL },            // inline → wrapper 크기
+    { "q78Div",                      "q78Div",                        benchQ78Div,         NULL },
+    { "fixMaUpdate",                 "fixMaUpdate",                   benchMa,             NULL },
+    { "fixIirUpdate",                "fixIirUpdate",                  benchIir,            NULL },
+    { "fixBiquadUpdate",             "fixBiquadUpdate",               benchBiquad,         NULL },
+    { "fixPidUpdate",                "fixPidUpdate",                  benchPid,            NULL },
+    { "fixLutInterp",                "fixLutInterp",                  benchLut,            NULL },
+    { "floatMul",                    "benchFloatMul",                 benchFloatMul,       NULL },            // float 기준
+    { "floatBiquad",                 "benchFloatBiquad",              benchFloatBiquad,    NULL },            // float 기준
+    { "fwCrcStep",                   "fwCrcStep",                     benchFwCrc,          NULL },
+    { "keypadScan",                  "keypadScan",                    benchKeypadScan,     NULL },
+    { "traceRecord",                 "benchTraceRecord",              benchTraceRecord,    NULL },            // inline → wrapper 크기
+};
+
+#define BENCH_MAX   (sizeof(bench_tbl) / sizeof(bench_tbl[0]))
+
+
+/* -------------------------------------------------------------------------- */
+/*                               COUNTER BACKEND                              */
+/* -------------------------------------------------------------------------- */
+#if (MCU_TYPE == MCU_ATMEGA128)
+
+static void benchCounterInit(void)
+{
+    TCCR3A = 0x00;
+    TCCR3B = (1 << CS30);        // normal mode, clk/1 → 1 count = 1 cycle
+}
+
+/**
+ * @brief  Measure one call in CPU cycles (인터럽트 금지 상태에서 측정)
+ */
+static uint32_t benchMeasure(void (*fn)(void))
+{
+    uint16_t t0, t1;
+    uint8_t sreg = SREG;
+
+    cli();
+    t0 = TCNT3;
+    fn();
+    t1 = TCNT3;
+    SREG = sreg;
+
+    return (uint16_t)(t1 - t0);
+}
+
+#elif (MCU_TYPE == MCU_HOST)
+
+static void benchCounterInit(void)
+{
+}
+
+static uint64_t benchNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  Measure average ns per call over BENCH_HOST_LOOP calls
+ */
+static uint32_t benchMeasure(void (*fn)(void))
+{
+    uint64_t t0 = benchNowNs();
+
+    for (uint32_t i = 0; i < BENCH_HOST_LOOP; i++)
+        fn();
+
+    return (uint32_t)((benchNowNs() - t0) / BENCH_HOST_LOOP);
+}
+
+#endif /* MCU_TYPE */
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  OUTPUT                                    */
+/* -------------------------------------------------------------------------- */
+static void benchPrintU32(uint32_t v)
+{
+    char buf[11];
+    uint8_t i = sizeof(buf) - 1;
+
+    buf[i] = '\0';
+    do
+    {
+        buf[--i] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v && i);
+
+    uartPrint(&buf[i]);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                BENCH RUNNER                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Run every case BENCH_REPEAT times and print
+ *         "BENCH,<name>,<min>,<max>,<sym>" (측정 오버헤드 제거 후)
+ */
+static void benchRun(void)
+{
+    uint32_t overhead = 0xFFFFFFFFUL;
+
+    for (uint8_t r = 0; r < BENCH_REPEAT; r++)
+    {
+        uint32_t c = benchMeasure(benchEmpty);
+        if (c < overhead) overhead = c;
+    }
+
+    uartPrint("BENCH_UNIT,");
+    uartPrint((MCU_TYPE == MCU_ATMEGA128) ? "cycles" : "ns");
+    uartPrint("\r\n");
+
+    for (uint8_t i = 0; i < BENCH_MAX; i++)
+    {
+        uint32_t c_min = 0xFFFFFFFFUL;
+        uint32_t c_max = 0;
+
+        for (uint8_t r = 0; r < BENCH_REPEAT; r++)
+        {
+            uint32_t c;
+
+            if (bench_tbl[i].prep) bench_tbl[i].prep();
+
+            c = benchMeasure(bench_tbl[i].fn);
+            c = (c > overhead) ? (c - overhead) : 0;
+
+            if (c < c_min) c_min = c;
+            if (c > c_max) c_max = c;
+
+            delay_us(100);      // tick ISR / task 주기가 측정 사이에 진행되도록
+        }
+
+        uartPrint("BENCH,");
+        uartPrint(bench_tbl[i].name);
+        uartPrint(",");
+        benchPrintU32(c_min);
+        uartPrint(",");
+        benchPrintU32(c_max);
+        uartPrint(",");
+        uartPrint(bench_tbl[i].sym);
+        uartPrint("\r\n");
+    }
+
+    uartPrint("BENCH_DONE\r\n");
+    uartFlush(UART_CH0);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    appInit();                  // 실제 펌웨어와 동일한 HAL 초기화
+#if (MCU_TYPE == MCU_ATMEGA128)
+    captureInit(CAPTURE_MODE_PERIOD);   // TIMER3_CAPT_vect 측정용 (Timer3 는 아래에서 카운터로 재설정)
+#endif
+    benchCounterInit();
+    softTimerStart(&bench_tmr, 1000);
+    traceInit();                // traceRecord 측정용 (_USE_TRACE 와 무관하게 기록)
+    fixMaInit(&bench_ma, bench_ma_buf, 4, 0);
+    fixIirInit(&bench_iir, Q15(0.1), 0);
+    fixBiquadInit(&bench_bq, Q14(0.0201), Q14(0.0402), Q14(0.0201), Q14(-1.5610), Q14(0.6414));
+    fixPidInit(&bench_pid, Q7_8(1.5), Q7_8(0.05), Q7_8(0.5), -1000, 1000);
+#if (MCU_TYPE == MCU_ATMEGA128)
+    // software PWM ISR 측정용: pwmSwInit() 없이 attach → Timer2 정지, ISR 은 직접 호출
+    // 핀은 bench 전용 PF0 ~ PF3 (app_config.h APP_GPIO_MAP_BENCH, LCD 버스와 분리)
+    pwmSwAttach(0, GPIO_BENCH_PWM0);
+    pwmSwAttach(1, GPIO_BENCH_PWM1);
+    pwmSwAttach(2, GPIO_BENCH_PWM2);
+    pwmSwAttach(3, GPIO_BENCH_PWM3);
+    pwmSwSetDuty(0, 40);
+    pwmSwSetDuty(1, 80);
+    pwmSwSetDuty(2, 120);
+    pwmSwSetDuty(3, 200);
+#endif
+    uartOpen(UART_CH1, 1000000);    // uartWriteCh 측정용 (1 byte = 10µs, 측정 간격 내 송신 완료)
+
+    benchRun();
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+    // 인터럽트 금지 + sleep → simavr 정상 종료
+    cli();
+    sleep_enable();
+    sleep_cpu();
+#endif
+
+    return 0;
+}
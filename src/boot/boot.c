@@ -0,0 +1,416 @@
+/*
+ * File: boot.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: UART streaming bootloader (ATmega128 boot section 8KB, env:boot)
+ *              avrdude/ISP 없이 USART0 로 app 영역(0x00000 ~ 0x1DFFF)을 갱신한다.
+ *
+ * 동작: reset → boot section 시작 (BOOTRST, BOOTSZ = 4096 words)
+ *       app 이 있으면 BOOT_WAIT_MS 동안 'H' 대기, 오지 않으면 → app 으로 jump
+ *       app 이 없으면 (0x0000 = 0xFFFF) 계속 부트로더에 머무름
+ *
+ * Streaming: app 영역은 RWW 영역 → 소거/기록(SPM) 중에도 boot 코드는 계속 실행된다.
+ *       page N 수신(버퍼 A) 중에 page N-1(버퍼 B)을 erase → fill → write → verify.
+ *       ACK(N) 는 page N-1 완료 후 page N 기록을 시작하면서 전송
+ *       → 호스트의 page N+1 전송 시간이 page N 기록 시간 뒤에 숨음.
+ *       page 0 은 DONE 에서 마지막에 기록 (중간에 끊기면 app 무효 → 부트로더 유지).
+ *       DONE 에서 새 이미지 뒤 ~ BOOT_APP_END 의 비어 있지 않은 page 를 지움
+ *       → 이전(더 긴) 이미지의 잔여 코드/데이터가 남지 않음.
+ *
+ * Protocol (호스트: tools/boot_upload.py, 8N1, BOOT_BAUD):
+ *   'H'                          → 'B' 'L' ver page_shift pages_lo pages_hi
+ *   'B' seq(LE16) data[256] crc(BE16)
+ *                                → ACK / NAK (CRC, 순서 오류 → 재전송) / ERR (범위 밖)
+ *         crc = CRC-16/XMODEM(seq + data), seq = page 번호 (주소 = seq × 256)
+ *   'D'                          → ACK (기록 + verify 성공, app 으로 jump) / ERR
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "def.h"
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+#include <avr/boot.h>
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 BOOT CONFIG                                 */
+/* -------------------------------------------------------------------------- */
+#ifndef BOOT_BAUD
+#define BOOT_BAUD           1000000UL   // 16MHz: 1M/500k/250k 오차 0% (U2X)
+#endif
+
+#ifndef BOOT_WAIT_MS
+#define BOOT_WAIT_MS        500         // reset 후 'H' 대기 시간
+#endif
+
+#define BOOT_BYTE_MS        100         // frame 내 byte 간 timeout
+
+#define BOOT_UBRR           ((F_CPU + 4UL * BOOT_BAUD) / (8UL * BOOT_BAUD) - 1)
+#define BOOT_MS_TICKS(ms)   ((uint16_t)((ms) * (F_CPU / 1024UL) / 1000UL))   // Timer1 clk/1024
+
+#define BOOT_PAGE           SPM_PAGESIZE                    // 256 byte
+#define BOOT_PAGE_SHIFT     8
+#define BOOT_APP_END        0x1E000UL                       // boot section 시작 (BOOTSZ = 00)
+#define BOOT_APP_PAGES      ((uint16_t)(BOOT_APP_END / BOOT_PAGE))   // 480
+
+#define BOOT_FILL_WORDS     4           // poll 1회당 page buffer fill word 수 (1M baud: byte 당 160 cycle)
+#define BOOT_VERIFY_BYTES   8           // poll 1회당 read-back 비교 byte 수
+
+#if (BOOT_PAGE != (1 << BOOT_PAGE_SHIFT))
+#error "BOOT_PAGE_SHIFT does not match SPM_PAGESIZE"
+#endif
+
+#if (BOOT_WAIT_MS * (F_CPU / 1024UL) / 1000UL == 0) || (BOOT_WAIT_MS * (F_CPU / 1024UL) / 1000UL > 0xFFFF)
+#error "BOOT_WAIT_MS out of Timer1 range"
+#endif
+
+#define BOOT_VERSION        1
+
+#define BOOT_CMD_HELLO      'H'
+#define BOOT_CMD_BLOCK      'B'
+#define BOOT_CMD_DONE       'D'
+
+#define BOOT_ACK            0x06
+#define BOOT_NAK            0x15        // 재전송 요청
+#define BOOT_ERR            0x18        // 재전송 무의미 (범위 밖, verify 실패)
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TYPE DEFINITIONS                              */
+/* -------------------------------------------------------------------------- */
+typedef enum
+{
+    FLASH_IDLE = 0,
+    FLASH_ERASE,        // page erase 진행 중
+    FLASH_FILL,         // SPM page buffer 채우는 중
+    FLASH_WRITE,        // page write 진행 중
+    FLASH_VERIFY        // read-back 비교 중
+} boot_flash_state_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL VARIABLES                               */
+/* -------------------------------------------------------------------------- */
+static uint8_t  boot_buf[2][BOOT_PAGE];    // 수신 / 기록 교대 버퍼
+static uint8_t  boot_page0[BOOT_PAGE];     // DONE 까지 보류하는 page 0
+
+static boot_flash_state_t flash_state;
+static const uint8_t     *flash_src;       // 기록 중인 버퍼
+static uint32_t           flash_addr;      // 기록 중인 page 주소
+static uint16_t           flash_pos;       // fill / verify 위치
+static bool               flash_bad;       // verify 실패 발생
+
+static bool               boot_tx;         // 전송한 byte 있음 (jump 전 TXC 대기)
+
+
+/* -------------------------------------------------------------------------- */
+/*                                FLASH ENGINE                                 */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start erase + write + verify of one page (FLASH_IDLE 상태에서만)
+ */
+static void bootFlashStart(const uint8_t *src, uint32_t addr)
+{
+    flash_src   = src;
+    flash_addr  = addr;
+    flash_pos   = 0;
+    flash_state = FLASH_ERASE;
+
+    boot_page_erase(addr);      // RWW 영역: CPU 는 멈추지 않음
+}
+
+/**
+ * @brief  Advance flash job by one short step (UART byte 간격 안에 끝나는 양만)
+ */
+static void bootFlashPoll(void)
+{
+    if (flash_state == FLASH_IDLE || boot_spm_busy()) return;
+
+    switch (flash_state)
+    {
+        case FLASH_ERASE:
+            flash_state = FLASH_FILL;
+            break;
+
+        case FLASH_FILL:
+            for (uint8_t n = 0; n < BOOT_FILL_WORDS; n++, flash_pos += 2)
+                boot_page_fill(flash_addr + flash_pos,
+                               flash_src[flash_pos] | ((uint16_t)flash_src[flash_pos + 1] << 8));
+
+            if (flash_pos >= BOOT_PAGE)
+            {
+                boot_page_write(flash_addr);
+                flash_state = FLASH_WRITE;
+            }
+            break;
+
+        case FLASH_WRITE:
+            boot_rww_enable();      // RWW 영역 읽기 허용 → verify
+            flash_pos   = 0;
+            flash_state = FLASH_VERIFY;
+            break;
+
+        case FLASH_VERIFY:
+            for (uint8_t n = 0; n < BOOT_VERIFY_BYTES; n++, flash_pos++)
+            {
+                if (pgm_read_byte_far(flash_addr + flash_pos) != flash_src[flash_pos])
+                    flash_bad = true;
+            }
+
+            if (flash_pos >= BOOT_PAGE)
+                flash_state = FLASH_IDLE;
+            break;
+
+        default:
+            flash_state = FLASH_IDLE;
+            break;
+    }
+}
+
+static void bootFlashWait(void)
+{
+    while (flash_state != FLASH_IDLE)
+        bootFlashPoll();
+}
+
+static bool bootPageBlank(uint32_t addr)
+{
+    for (uint16_t i = 0; i < BOOT_PAGE; i++)
+    {
+        if (pgm_read_byte_far(addr + i) != 0xFF) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief  Erase every non-blank page from page 'from' to BOOT_APP_END
+ *         빈 page 는 읽기만 (page 당 약 256 × 8 cycle), 지우는 page 만 erase 시간 (최대 4.5ms).
+ *         DONE 처리 중 동기 실행 → 호스트는 남은 page 수만큼 응답 대기 시간을 늘림.
+ */
+static void bootEraseTail(uint16_t from)
+{
+    for (uint16_t pg = from; pg < BOOT_APP_PAGES; pg++)
+    {
+        uint32_t addr = (uint32_t)pg << BOOT_PAGE_SHIFT;
+
+        if (bootPageBlank(addr)) continue;
+
+        boot_page_erase(addr);
+        boot_spm_busy_wait();
+        boot_rww_enable();
+
+        if (!bootPageBlank(addr)) flash_bad = true;
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                    UART                                     */
+/* -------------------------------------------------------------------------- */
+/*
+ * 인터럽트 미사용 (vector table 은 app 영역에 그대로) → polling.
+ * 수신 대기 중에 bootFlashPoll() 을 돌려 flash 작업을 진행한다.
+ */
+static void bootUartInit(void)
+{
+    UBRR0H = (uint8_t)(BOOT_UBRR >> 8);
+    UBRR0L = (uint8_t)BOOT_UBRR;
+    UCSR0A = (1 << U2X0);
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);     // 8N1
+    UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+}
+
+/**
+ * @brief  Receive one byte, flash 작업을 틈틈이 진행
+ * @param  ticks timeout (Timer1 clk/1024 tick, BOOT_MS_TICKS())
+ * @return 0 ~ 255, -1 = timeout
+ */
+static int16_t bootGetc(uint16_t ticks)
+{
+    uint16_t start = TCNT1;
+
+    while (!(UCSR0A & (1 << RXC0)))
+    {
+        bootFlashPoll();
+        if ((uint16_t)(TCNT1 - start) >= ticks) return -1;
+    }
+    return UDR0;
+}
+
+static void bootPutc(uint8_t c)
+{
+    while (!(UCSR0A & (1 << UDRE0)))
+        bootFlashPoll();
+
+    UCSR0A  = (1 << U2X0) | (1 << TXC0);        // TXC clear (1 기록)
+    UDR0    = c;
+    boot_tx = true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  PROTOCOL                                   */
+/* -------------------------------------------------------------------------- */
+static void bootHello(void)
+{
+    bootPutc('B');
+    bootPutc('L');
+    bootPutc(BOOT_VERSION);
+    bootPutc(BOOT_PAGE_SHIFT);
+    bootPutc((uint8_t)BOOT_APP_PAGES);
+    bootPutc((uint8_t)(BOOT_APP_PAGES >> 8));
+}
+
+/**
+ * @brief  Receive block body after 'B' (seq + data + crc)
+ *         CRC 는 수신과 동시에 갱신, CRC(BE) 까지 넣으면 0 이 되어야 함.
+ * @return true = CRC 일치
+ */
+static bool bootRecvBlock(uint8_t *buf, uint16_t *p_seq)
+{
+    uint16_t crc = 0;
+    int16_t  c;
+
+    for (uint16_t i = 0; i < 2 + BOOT_PAGE + 2; i++)
+    {
+        if ((c = bootGetc(BOOT_MS_TICKS(BOOT_BYTE_MS))) < 0) return false;
+
+        crc = _crc_xmodem_update(crc, (uint8_t)c);
+
+        if (i < 2)
+            ((uint8_t *)p_seq)[i] = (uint8_t)c;     // LE
+        else if (i < 2 + BOOT_PAGE)
+            buf[i - 2] = (uint8_t)c;
+    }
+    return crc == 0;
+}
+
+static bool bootAppValid(void)
+{
+    return pgm_read_word_far(0) != 0xFFFF;      // reset vector 미기록 = app 없음
+}
+
+static void bootJumpApp(void)
+{
+    bootFlashWait();
+    boot_rww_enable();
+
+    while (boot_tx && !(UCSR0A & (1 << TXC0)))  // 마지막 응답 전송 완료
+        ;
+
+    // reset 상태로 복원 (app 의 init 가정과 일치)
+    UCSR0B = 0;
+    UCSR0A = 0;
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+    UBRR0H = 0;
+    UBRR0L = 0;
+    TCCR1B = 0;
+    TCNT1  = 0;
+
+    ((void (*)(void))0)();
+}
+
+/**
+ * @brief  Command loop (app 으로 jump 하기 전까지 반환하지 않음)
+ */
+static void bootLoop(void)
+{
+    uint16_t next = 0;      // 다음 기대 seq
+    uint8_t  rx   = 0;      // 수신 버퍼 index (다른 쪽은 기록 중일 수 있음)
+
+    for (;;)
+    {
+        switch (bootGetc(0xFFFF))
+        {
+            case BOOT_CMD_HELLO:
+                bootFlashWait();
+                next      = 0;
+                flash_bad = false;
+                bootHello();
+                break;
+
+            case BOOT_CMD_BLOCK:
+            {
+                uint16_t seq;
+                uint8_t  res = BOOT_ACK;
+
+                if (!bootRecvBlock(boot_buf[rx], &seq)) res = BOOT_NAK;
+                else if (seq >= BOOT_APP_PAGES)          res = BOOT_ERR;
+                else if (seq == (uint16_t)(next - 1))    res = BOOT_ACK;    // ACK 유실 → 재전송분, 무시
+                else if (seq != next)                    res = BOOT_NAK;
+                else
+                {
+                    bootFlashWait();    // 이전 page 완료 → 그 버퍼가 다음 수신 버퍼
+
+                    if (seq == 0)
+                    {
+                        // page 0 은 보류, 지금은 지우기만 (0xFF 기록) → 중단 시 app 무효
+                        memcpy(boot_page0, boot_buf[rx], BOOT_PAGE);
+                        memset(boot_buf[rx], 0xFF, BOOT_PAGE);
+                    }
+                    bootFlashStart(boot_buf[rx], (uint32_t)seq << BOOT_PAGE_SHIFT);
+
+                    rx ^= 1;
+                    next++;
+                }
+                bootPutc(res);
+                break;
+            }
+
+            case BOOT_CMD_DONE:
+                bootFlashWait();
+                if (next > 0)
+                {
+                    bootEraseTail(next);                // page 0 기록 전 → 중단 시 app 무효 유지
+                    bootFlashStart(boot_page0, 0);
+                    bootFlashWait();
+                }
+
+                if (flash_bad || !bootAppValid())
+                {
+                    bootPutc(BOOT_ERR);
+                    break;
+                }
+                bootPutc(BOOT_ACK);
+                bootJumpApp();
+                break;
+
+            default:                // timeout / 잡음
+                break;
+        }
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                    MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    cli();
+
+    // app 의 watchdog reset 으로 진입한 경우 WDT 정지
+    MCUCSR = 0;
+    WDTCR  = (1 << WDCE) | (1 << WDE);
+    WDTCR  = 0;
+
+    TCCR1A = 0;
+    TCCR1B = (1 << CS12) | (1 << CS10);         // clk/1024: timeout 기준
+    bootUartInit();
+
+    if (bootAppValid())
+    {
+        if (bootGetc(BOOT_MS_TICKS(BOOT_WAIT_MS)) != BOOT_CMD_HELLO)
+            bootJumpApp();
+        bootHello();
+    }
+
+    bootLoop();
+
+    return 0;   // 도달하지 않음
+}
+
+#endif /* MCU_TYPE == MCU_ATMEGA128 */
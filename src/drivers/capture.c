@@ -0,0 +1,242 @@
+/*
+ * File: capture.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: ATmega128 Timer3 input-capture driver
+ *              ICR3 (16bit) + overflow 카운터 → 32bit 타임스탬프,
+ *              주기/HIGH 폭 링버퍼와 누적합을 ISR 에서 유지.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "capture.h"
+#include "delay.h"   // g_ms, millis()
+
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL VARIABLES                              */
+/* -------------------------------------------------------------------------- */
+#define CAPTURE_RING_MASK   (CAPTURE_RING_SIZE - 1)
+
+#if (CAPTURE_RING_SIZE & CAPTURE_RING_MASK) || (CAPTURE_RING_SIZE > 128)
+#error "CAPTURE_RING_SIZE must be a power of 2 and <= 128"
+#endif
+
+static capture_mode_t    cap_mode;                         // 캡처 모드
+static volatile uint16_t cap_ovf_hi;                       // Timer3 overflow 횟수 (상위 16bit)
+
+static uint32_t          cap_period[CAPTURE_RING_SIZE];    // 주기 링버퍼 [tick]
+static uint32_t          cap_high[CAPTURE_RING_SIZE];      // HIGH 폭 링버퍼 [tick]
+static volatile uint32_t cap_period_sum;                   // 링버퍼 주기 합
+static volatile uint32_t cap_high_sum;                     // 링버퍼 HIGH 폭 합
+static uint8_t           cap_idx;                          // 다음 기록 위치
+static volatile uint8_t  cap_fill;                         // 유효 항목 수
+
+static uint32_t          cap_last_rise;                    // 직전 상승 엣지 시각
+static uint32_t          cap_cur_high;                     // 진행 중 주기의 HIGH 폭
+static bool              cap_have_rise;                    // 첫 상승 엣지 수신 여부
+static volatile uint32_t cap_count;                        // 누적 주기 수
+static volatile uint32_t cap_last_ms;                      // 마지막 엣지 시각 [ms]
+
+/* -------------------------------------------------------------------------- */
+/*                                RING RESET                                  */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Clear ring/sums → 다음 상승 엣지를 첫 엣지로 처리
+ *         ISR 에서도 호출 → inline + 루프 (함수 호출 시 ISR prologue 가 커짐)
+ */
+static inline __attribute__((always_inline)) void captureClear(void)
+{
+    for (uint8_t i = 0; i < CAPTURE_RING_SIZE; i++)
+    {
+        cap_period[i] = 0;
+        cap_high[i]   = 0;
+    }
+    cap_period_sum = 0;
+    cap_high_sum   = 0;
+    cap_idx        = 0;
+    cap_fill       = 0;
+    cap_cur_high   = 0;
+    cap_have_rise  = false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                CAPTURE INIT                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start Timer3 input capture on ICP3
+ */
+bool captureInit(capture_mode_t mode)
+{
+    if (TCCR3B & (1 << WGM33)) return false;       // Timer3 PWM 동작 중
+
+    cli();
+
+    cap_mode   = mode;
+    cap_ovf_hi = 0;
+    cap_count  = 0;
+    captureClear();
+
+    DDRE  &= ~(1 << 7);                            // ICP3 = PE7 input
+
+    TCCR3A = 0x00;                                 // normal mode
+    TCCR3B = (1 << ICNC3) | (1 << ICES3)           // noise canceler, rising edge
+           | (1 << CS30);                          // clk/1 → 62.5ns @16MHz
+    TCNT3  = 0;
+    ETIFR  = (1 << ICF3) | (1 << TOV3);
+    ETIMSK |= (1 << TICIE3) | (1 << TOIE3);
+
+    sei();
+    return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   ISR                                      */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Timer3 overflow → 상위 16bit 증가
+ */
+ISR(TIMER3_OVF_vect)
+{
+    cap_ovf_hi++;
+}
+
+/**
+ * @brief  Timer3 input capture
+ *         ICR3 가 overflow 직후 값인데 TOV3 가 아직 처리 전이면 상위 +1 보정.
+ *         CAPTURE_TIMEOUT_MS 이상 엣지가 없었으면 링버퍼를 비우고 첫 엣지부터 다시 시작
+ *         (공백 전체를 한 주기로 기록하지 않음).
+ */
+ISR(TIMER3_CAPT_vect)
+{
+    uint16_t icr = ICR3;
+    uint16_t hi  = cap_ovf_hi;
+    uint32_t ts;
+    bool     rising = true;
+
+    if ((ETIFR & (1 << TOV3)) && (icr < 0x8000))
+        hi++;
+    ts = ((uint32_t)hi << 16) | icr;
+
+    if (cap_have_rise && (g_ms - cap_last_ms) > CAPTURE_TIMEOUT_MS)
+        captureClear();                            // 신호 재개: 이전 링버퍼는 무효
+
+    if (cap_mode == CAPTURE_MODE_DUTY)
+    {
+        rising  = (TCCR3B & (1 << ICES3)) != 0;
+        TCCR3B ^= (1 << ICES3);                    // 반대 엣지 대기
+        ETIFR   = (1 << ICF3);                     // 엣지 변경 후 ICF 해제 (datasheet)
+
+        if (!rising)
+        {
+            if (cap_have_rise)
+                cap_cur_high = ts - cap_last_rise; // HIGH 폭 확정
+            return;
+        }
+    }
+
+    if (rising && cap_have_rise)
+    {
+        uint32_t period = ts - cap_last_rise;
+
+        cap_period_sum += period - cap_period[cap_idx];
+        cap_high_sum   += cap_cur_high - cap_high[cap_idx];
+        cap_period[cap_idx] = period;
+        cap_high[cap_idx]   = cap_cur_high;
+        cap_idx = (cap_idx + 1) & CAPTURE_RING_MASK;
+        if (cap_fill < CAPTURE_RING_SIZE) cap_fill++;
+        cap_count++;
+    }
+
+    cap_last_rise = ts;
+    cap_have_rise = true;
+    cap_last_ms   = g_ms;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Atomic snapshot of running sums
+ * @return 유효 항목 수 (타임아웃 시 0)
+ */
+static uint8_t captureSnapshot(uint32_t *p_period_sum, uint32_t *p_high_sum)
+{
+    uint8_t  sreg = SREG;
+    uint8_t  fill;
+    uint32_t last_ms;
+
+    cli();
+    *p_period_sum = cap_period_sum;
+    *p_high_sum   = cap_high_sum;
+    fill          = cap_fill;
+    last_ms       = cap_last_ms;
+    SREG = sreg;
+
+    if (fill == 0 || (millis() - last_ms) > CAPTURE_TIMEOUT_MS)
+        return 0;
+
+    return fill;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                CAPTURE API                                 */
+/* -------------------------------------------------------------------------- */
+uint32_t captureGetPeriod(void)
+{
+    uint32_t p_sum, h_sum;
+    uint8_t  n = captureSnapshot(&p_sum, &h_sum);
+
+    return n ? (p_sum / n) : 0;
+}
+
+uint32_t captureGetFreq(void)
+{
+    uint32_t period = captureGetPeriod();
+
+    // F_CPU × 100 = 1.6e9 (16MHz) → uint32 범위 내
+    return period ? ((F_CPU * 100UL) + (period / 2)) / period : 0;
+}
+
+uint16_t captureGetDuty(void)
+{
+    uint32_t p_sum, h_sum;
+
+    if (captureSnapshot(&p_sum, &h_sum) == 0 || p_sum == 0)
+        return 0;
+
+    // h ≤ p, p < 2^22 로 맞추면 h × 1000 이 uint32 를 넘지 않음
+    while (p_sum > 0x3FFFFFUL)
+    {
+        p_sum >>= 1;
+        h_sum >>= 1;
+    }
+
+    return (uint16_t)((h_sum * 1000UL) / p_sum);
+}
+
+uint32_t captureGetRpm(uint8_t pulses_per_rev)
+{
+    uint32_t period = captureGetPeriod();
+
+    if (period == 0 || pulses_per_rev == 0) return 0;
+
+    // F_CPU × 60 = 9.6e8 (16MHz) → uint32 범위 내
+    return (F_CPU * 60UL) / period / pulses_per_rev;
+}
+
+uint32_t captureGetCount(void)
+{
+    uint32_t n;
+    uint8_t  sreg = SREG;
+
+    cli();
+    n = cap_count;
+    SREG = sreg;
+
+    return n;
+}
+
+#endif /* MCU_ATMEGA128 */
@@ -4,12 +4,14 @@
  * Description: ATmega128 Delay & Time API
  *              Implemented using Timer1 (CTC mode) for stable 1ms tick
  *              and 4µs resolution micros().
+ *              MCU_HOST: CLOCK_MONOTONIC / virtual clock backend.
  */
 
 /* -------------------------------------------------------------------------- */
 /*                                INCLUDE FILES                               */
 /* -------------------------------------------------------------------------- */
 #include "delay.h"
+#include "trace.h"   // TRACE_ENTER/EXIT (_USE_TRACE + _USE_TRACE_TICK)
 
 
 #if (MCU_TYPE == MCU_ATMEGA128)
@@ -17,7 +19,7 @@
 /*                               LOCAL VARIABLES                              */
 /* -------------------------------------------------------------------------- */
 
-static volatile uint32_t g_ms = 0;   // 1ms tick counter
+volatile uint32_t g_ms = 0;          // 1ms tick counter (delay.h 참조)
 
 /* -------------------------------------------------------------------------- */
 /*                               delayInit()                                  */
@@ -89,6 +91,9 @@ uint32_t micros(void)
     cli();
     m = g_ms;      // ms
     t = TCNT1;     // timer ticks (4µs 단위)
+    // TCNT1 이 TOP 을 지났지만 tick ISR 이 아직 실행 전 (ISR 내부/cli 구간 호출)
+    if ((TIFR & (1 << OCF1A)) && (t < 125))
+        m++;
     SREG = sreg;
 
     // m * 1000us + t * 4us
@@ -130,7 +135,91 @@ void delay_ms(uint32_t ms)
  */
 ISR(TIMER1_COMPA_vect)
 {
+#ifdef _USE_TRACE_TICK
+    TRACE_ENTER(TRACE_EVT_ISR_TICK);
+#endif
     g_ms++;
+#ifdef _USE_TRACE_TICK
+    TRACE_EXIT(TRACE_EVT_ISR_TICK);
+#endif
 }
 
-#endif /* MCU_ATMEGA128 */
+#elif (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                                HOST BACKEND                                */
+/* -------------------------------------------------------------------------- */
+/* CLOCK_MONOTONIC 또는 테스트용 가상 시계를 사용                             */
+#include <time.h>
+
+volatile uint32_t g_ms = 0;            // millis() 호출 시 갱신 (trace 호환)
+
+static bool     host_virtual  = false; // 가상 시계 사용 여부
+static uint64_t host_virt_us  = 0;     // 가상 시계 [µs]
+static uint64_t host_start_us = 0;     // delayInit() 시점 monotonic [µs]
+
+static uint64_t hostMonotonicUs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000ULL) + ((uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+static uint64_t hostNowUs(void)
+{
+    if (host_virtual)
+        return host_virt_us;
+
+    return hostMonotonicUs() - host_start_us;
+}
+
+void delayInit(void)
+{
+    host_start_us = hostMonotonicUs();
+    host_virt_us  = 0;
+    g_ms          = 0;
+}
+
+void delayHostSetVirtual(bool enable)
+{
+    host_virt_us = hostNowUs();   // 전환 시 시간 연속성 유지
+    host_virtual = enable;
+    if (!enable)
+        host_start_us = hostMonotonicUs() - host_virt_us;
+}
+
+void delayHostAdvanceUs(uint32_t us)
+{
+    host_virt_us += us;
+}
+
+uint32_t millis(void)
+{
+    g_ms = (uint32_t)(hostNowUs() / 1000ULL);
+    return g_ms;
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)hostNowUs();
+}
+
+void delay_us(uint32_t us)
+{
+    if (host_virtual)
+    {
+        host_virt_us += us;   // 가상 시계: 즉시 진행
+        return;
+    }
+
+    struct timespec ts = { (time_t)(us / 1000000UL), (long)(us % 1000000UL) * 1000L };
+    nanosleep(&ts, NULL);
+}
+
+void delay_ms(uint32_t ms)
+{
+    while (ms--)
+        delay_us(1000);
+}
+
+#endif /* MCU_TYPE */
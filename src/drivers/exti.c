@@ -0,0 +1,237 @@
+/*
+ * File: exti.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: ATmega128 external interrupt (INT0 ~ INT7) driver
+ *              엣지 ISR 에서 g_ms/TCNT1 원시 타임스탬프 + 핀 레벨을 이벤트 큐에 저장
+ *              (µs 변환은 extiRead 에서), 핀별 엣지/overflow 카운터 유지.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "exti.h"
+#include "delay.h"   // g_ms
+
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL VARIABLES                              */
+/* -------------------------------------------------------------------------- */
+#define EXTI_QUEUE_MASK     (EXTI_QUEUE_SIZE - 1)
+#define EXTI_LINE_NONE      0xFF
+
+#if (EXTI_QUEUE_SIZE & EXTI_QUEUE_MASK) || (EXTI_QUEUE_SIZE > 256)
+#error "EXTI_QUEUE_SIZE must be a power of 2 and <= 256"
+#endif
+
+/* ISC 값: 10 = falling, 11 = rising, 01 = any edge (INT4~7 전용) */
+#define EXTI_ISC_ANY        1
+#define EXTI_ISC_FALLING    2
+#define EXTI_ISC_RISING     3
+
+/* ISR 기록 형식: micros() 호출/32bit 곱셈 없이 g_ms + TCNT1L 만 저장 */
+typedef struct
+{
+    gpio_id_t id;
+    uint8_t   level;
+    uint8_t   tick;          // TCNT1L (4µs 단위, 0 ~ 249)
+    uint32_t  ms;            // g_ms (미처리 tick 보정 포함)
+} exti_raw_t;
+
+static exti_raw_t        exti_queue[EXTI_QUEUE_SIZE];    // 엣지 이벤트 큐
+static volatile uint8_t  exti_head;                      // ISR 기록 위치
+static volatile uint8_t  exti_tail;                      // task 읽기 위치
+
+static gpio_id_t         exti_line_id[EXTI_LINE_MAX];    // INTn → 논리 GPIO
+static volatile uint32_t exti_edges[EXTI_LINE_MAX];      // INTn 누적 엣지 수
+static volatile uint16_t exti_ovf[EXTI_LINE_MAX];        // INTn 큐 overflow 수
+static uint8_t           exti_both;                      // INT0~3 양 엣지 에뮬레이션 비트맵
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Logical GPIO → INT line number
+ * @return 0 ~ 7, 해당 없음 = EXTI_LINE_NONE
+ */
+static uint8_t extiGetLine(gpio_id_t id)
+{
+    gpio_reg_t reg;
+    uint8_t pin = 0;
+
+    if (!gpioGetReg(id, &reg)) return EXTI_LINE_NONE;
+
+    while (!(reg.mask & (1 << pin))) pin++;
+
+    if (reg.port == PORT_D && pin <= 3) return pin;     // INT0~3
+    if (reg.port == PORT_E && pin >= 4) return pin;     // INT4~7
+
+    return EXTI_LINE_NONE;
+}
+
+/**
+ * @brief  Write ISCn bits of line (EICRA: INT0~3, EICRB: INT4~7)
+ */
+static inline __attribute__((always_inline)) void extiSetIsc(uint8_t line, uint8_t isc)
+{
+    if (line < 4)
+        EICRA = (EICRA & ~(3 << (line * 2))) | (isc << (line * 2));
+    else
+        EICRB = (EICRB & ~(3 << ((line - 4) * 2))) | (isc << ((line - 4) * 2));
+}
+
+/* -------------------------------------------------------------------------- */
+/*                                   ISR                                      */
+/* -------------------------------------------------------------------------- */
+/* always_inline: 벡터별 상수 line → 레지스터/비트 연산이 상수로 접힘
+ * 타임스탬프는 traceRecord() 와 같은 방식으로 inline 읽기 (함수 호출 없음 → call-used 레지스터 저장 없음) */
+static inline __attribute__((always_inline)) void extiIsr(uint8_t line)
+{
+    uint32_t ms    = g_ms;
+    uint8_t  tick  = TCNT1L;
+    uint8_t  level = (line < 4) ? ((PIND >> line) & 1) : ((PINE >> line) & 1);
+    uint8_t  next;
+
+    // TCNT1 이 TOP 을 지났지만 tick ISR 실행 전 → micros() 와 같은 보정
+    if ((TIFR & (1 << OCF1A)) && (tick < 125))
+        ms++;
+
+    if ((line < 4) && (exti_both & (1 << line)))
+    {
+        // INT0~3 은 any-edge 미지원 → 현재 레벨의 반대 엣지로 재설정
+        extiSetIsc(line, level ? EXTI_ISC_FALLING : EXTI_ISC_RISING);
+        EIFR = (1 << line);
+    }
+
+    exti_edges[line]++;
+
+    next = (exti_head + 1) & EXTI_QUEUE_MASK;
+    if (next == exti_tail)
+    {
+        exti_ovf[line]++;           // 큐 가득 참 → 버림 (카운터만 증가)
+        return;
+    }
+
+    exti_queue[exti_head].id    = exti_line_id[line];
+    exti_queue[exti_head].level = level;
+    exti_queue[exti_head].tick  = tick;
+    exti_queue[exti_head].ms    = ms;
+    exti_head = next;
+}
+
+ISR(INT0_vect) { extiIsr(0); }
+ISR(INT1_vect) { extiIsr(1); }
+ISR(INT2_vect) { extiIsr(2); }
+ISR(INT3_vect) { extiIsr(3); }
+ISR(INT4_vect) { extiIsr(4); }
+ISR(INT5_vect) { extiIsr(5); }
+ISR(INT6_vect) { extiIsr(6); }
+ISR(INT7_vect) { extiIsr(7); }
+
+/* -------------------------------------------------------------------------- */
+/*                                  EXTI API                                  */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Enable external interrupt on logical GPIO
+ */
+bool extiAttach(gpio_id_t id, exti_edge_t edge)
+{
+    uint8_t line = extiGetLine(id);
+    uint8_t isc;
+    uint8_t sreg;
+
+    if (line == EXTI_LINE_NONE) return false;
+
+    if (edge == EXTI_EDGE_FALLING)     isc = EXTI_ISC_FALLING;
+    else if (edge == EXTI_EDGE_RISING) isc = EXTI_ISC_RISING;
+    else if (line >= 4)                isc = EXTI_ISC_ANY;
+    else                               isc = gpioRead(id) ? EXTI_ISC_FALLING : EXTI_ISC_RISING;
+
+    sreg = SREG;
+    cli();
+
+    EIMSK &= ~(1 << line);                      // ISC 변경 중 오동작 방지
+    exti_line_id[line] = id;
+    exti_edges[line]   = 0;
+    exti_ovf[line]     = 0;
+    if (line < 4 && edge == EXTI_EDGE_BOTH) exti_both |=  (1 << line);
+    else                                    exti_both &= ~(1 << line);
+
+    extiSetIsc(line, isc);
+    EIFR   = (1 << line);                       // 설정 변경으로 생긴 플래그 제거
+    EIMSK |= (1 << line);
+
+    SREG = sreg;
+    return true;
+}
+
+/**
+ * @brief  Disable external interrupt on logical GPIO
+ */
+void extiDetach(gpio_id_t id)
+{
+    uint8_t line = extiGetLine(id);
+
+    if (line == EXTI_LINE_NONE) return;
+
+    EIMSK &= ~(1 << line);
+}
+
+/**
+ * @brief  Pop oldest edge event
+ */
+bool extiRead(exti_evt_t *p_evt)
+{
+    uint8_t tail = exti_tail;
+    const exti_raw_t *p_raw;
+
+    if (p_evt == NULL || tail == exti_head) return false;
+
+    p_raw        = &exti_queue[tail];
+    p_evt->id    = p_raw->id;
+    p_evt->level = p_raw->level;
+    p_evt->us    = (p_raw->ms * 1000UL) + (p_raw->tick * 4UL);    // micros() 와 같은 변환
+    exti_tail = (tail + 1) & EXTI_QUEUE_MASK;
+
+    return true;
+}
+
+/**
+ * @brief  Total edges seen on pin
+ */
+uint32_t extiGetEdgeCount(gpio_id_t id)
+{
+    uint8_t  line = extiGetLine(id);
+    uint32_t n;
+    uint8_t  sreg;
+
+    if (line == EXTI_LINE_NONE) return 0;
+
+    sreg = SREG;
+    cli();
+    n = exti_edges[line];
+    SREG = sreg;
+
+    return n;
+}
+
+/**
+ * @brief  Edges dropped on pin because queue was full
+ */
+uint16_t extiGetOverflow(gpio_id_t id)
+{
+    uint8_t  line = extiGetLine(id);
+    uint16_t n;
+    uint8_t  sreg;
+
+    if (line == EXTI_LINE_NONE) return 0;
+
+    sreg = SREG;
+    cli();
+    n = exti_ovf[line];
+    SREG = sreg;
+
+    return n;
+}
+
+#endif /* MCU_ATMEGA128 */
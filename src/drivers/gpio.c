@@ -2,6 +2,7 @@
  * File: gpio.c
  * Author: Young Kwan CHO, Lilith
  * Description: ATmega128 GPIO HAL Wrapper (ENUM-based logical GPIO control)
+ *              MCU_HOST: 포트 레지스터를 메모리 배열로 대체 (테스트에서 관찰 가능)
  */
 
 /* -------------------------------------------------------------------------- */
@@ -10,30 +11,69 @@
 #include "gpio.h"
 
 
-#if (MCU_TYPE == MCU_ATMEGA128)
+#if (MCU_TYPE == MCU_ATMEGA128) || (MCU_TYPE == MCU_HOST)
 /* -------------------------------------------------------------------------- */
 /*                             GPIO CONFIG TABLE                              */
 /* -------------------------------------------------------------------------- */
-/* Logical GPIO → Physical Port/Pin/Mode mapping                               */
-/* 이 테이블만 수정하면 MCU 핀 변경, PCB REV 변경에도 APP 코드는 수정 불필요 */
+/* Logical GPIO → Physical Port/Mask mapping (app_config.h APP_GPIO_MAP 에서 생성) */
+/* 마스크는 컴파일 타임 계산 → 런타임 가변 shift 없음, AVR 은 flash 에 배치       */
+#if (MCU_TYPE == MCU_ATMEGA128)
+#include <avr/pgmspace.h>
+#define GPIO_FLASH          PROGMEM
+#define GPIO_RD(field)      pgm_read_byte(&(field))
+#else
+#define GPIO_FLASH
+#define GPIO_RD(field)      (field)
+#endif
+
 typedef struct
 {
-    uint8_t port;
-    uint8_t pin;
-    gpio_mode_t mode;
+    uint8_t port;        // 논리 포트 번호 (PORT_A ~ PORT_G)
+    uint8_t mask;        // 핀 비트 마스크 (1 << pin)
 } gpio_cfg_t;
 
-static const gpio_cfg_t gpio_table[GPIO_MAX] =
+static const gpio_cfg_t gpio_table[GPIO_MAX] GPIO_FLASH =
 {
-    { PORT_B, 0, GPIO_OUTPUT }, // GPIO_LED
-    // { PORT_D, 2, GPIO_INPUT  }, // GPIO_BUTTON
-    // { PORT_C, 3, GPIO_OUTPUT }, // GPIO_SPI_CS
+#define GPIO_X_CFG(id, port, pin, mode)     [id] = { (port), (uint8_t)(1 << (pin)) },
+    APP_GPIO_MAP(GPIO_X_CFG)
+#undef GPIO_X_CFG
 };
 
+/* -------------------------------------------------------------------------- */
+/*                          COMPILE-TIME VALIDATION                           */
+/* -------------------------------------------------------------------------- */
+/* 전체 핀 = 64bit 비트맵 (bit = port × 8 + pin, PORT_A ~ PORT_G = 56bit) */
+#define GPIO_BIT(port, pin)                 (1ULL << ((port) * 8 + (pin)))
+#define GPIO_PORT_BYTE(bits, port)          ((uint8_t)((bits) >> ((port) * 8)))
+
+#define GPIO_X_RANGE(id, port, pin, mode)   && ((port) <= PORT_G) && ((pin) < 8)
+#define GPIO_X_COUNT(id, port, pin, mode)   + 1
+#define GPIO_X_SUM(id, port, pin, mode)     + GPIO_BIT(port, pin)
+#define GPIO_X_USED(id, port, pin, mode)    | GPIO_BIT(port, pin)
+#define GPIO_X_OUT(id, port, pin, mode)     | (((mode) == GPIO_OUTPUT) ? GPIO_BIT(port, pin) : 0)
+#define GPIO_X_PULLUP(id, port, pin, mode)  | (((mode) == GPIO_INPUT_PULLUP) ? GPIO_BIT(port, pin) : 0)
+
+#define GPIO_USED_BITS      (0ULL APP_GPIO_MAP(GPIO_X_USED))    // 사용 핀
+#define GPIO_OUT_BITS       (0ULL APP_GPIO_MAP(GPIO_X_OUT))     // DDR = 1
+#define GPIO_PULLUP_BITS    (0ULL APP_GPIO_MAP(GPIO_X_PULLUP))  // 입력 + PORT = 1
+
+_Static_assert(1 APP_GPIO_MAP(GPIO_X_RANGE), "APP_GPIO_MAP: port/pin out of range");
+_Static_assert((0 APP_GPIO_MAP(GPIO_X_COUNT)) == GPIO_MAX &&
+               sizeof(gpio_table) / sizeof(gpio_table[0]) == GPIO_MAX,
+               "gpio_table / gpio_id_t size mismatch");
+/* 중복 핀이 있으면 합(+)과 OR(|)이 달라짐 */
+_Static_assert((0ULL APP_GPIO_MAP(GPIO_X_SUM)) == GPIO_USED_BITS,
+               "APP_GPIO_MAP: same pin assigned to more than one GPIO id");
+
 /* -------------------------------------------------------------------------- */
 /*                     INTERNAL REGISTER ACCESS HELPERS                        */
 /* -------------------------------------------------------------------------- */
 /* 포트번호(enum) → AVR 레지스터 반환 (MCU 독립 API) */
+#if (MCU_TYPE == MCU_ATMEGA128)
+
+/* 출력 RMW 보호: ISR(software PWM 등)이 같은 포트를 갱신해도 비트 손실 없음 */
+#define GPIO_LOCK()     uint8_t sreg = SREG; cli()
+#define GPIO_UNLOCK()   SREG = sreg
 
 static inline volatile uint8_t* gpio_get_ddr(uint8_t port)
 {
@@ -80,25 +120,94 @@ static inline volatile uint8_t* gpio_get_pin(uint8_t port)
     }
 }
 
+#elif (MCU_TYPE == MCU_HOST)
+
+#define HOST_PORT_MAX   (PORT_G + 1)
+
+#define GPIO_LOCK()     ((void)0)
+#define GPIO_UNLOCK()   ((void)0)
+
+static uint8_t host_ddr[HOST_PORT_MAX];    // DDRx 대체
+static uint8_t host_port[HOST_PORT_MAX];   // PORTx 대체
+static uint8_t host_pin[HOST_PORT_MAX];    // PINx 대체 (gpioHostSetInput()으로 설정)
+
+static inline volatile uint8_t* gpio_get_ddr(uint8_t port)
+{
+    return (port < HOST_PORT_MAX) ? (volatile uint8_t *)&host_ddr[port] : 0;
+}
+
+static inline volatile uint8_t* gpio_get_port(uint8_t port)
+{
+    return (port < HOST_PORT_MAX) ? (volatile uint8_t *)&host_port[port] : 0;
+}
+
+static inline volatile uint8_t* gpio_get_pin(uint8_t port)
+{
+    return (port < HOST_PORT_MAX) ? (volatile uint8_t *)&host_pin[port] : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                              HOST TEST HOOKS                               */
+/* -------------------------------------------------------------------------- */
+uint8_t gpioHostGetOutput(gpio_id_t id)
+{
+    if (id >= GPIO_MAX) return 0;
+
+    return (host_port[gpio_table[id].port] & gpio_table[id].mask) ? 1 : 0;
+}
+
+gpio_mode_t gpioHostGetMode(gpio_id_t id)
+{
+    if (id >= GPIO_MAX) return GPIO_INPUT;
+
+    return (host_ddr[gpio_table[id].port] & gpio_table[id].mask) ? GPIO_OUTPUT : GPIO_INPUT;
+}
+
+void gpioHostSetInput(gpio_id_t id, gpio_state_t state)
+{
+    if (id >= GPIO_MAX) return;
+
+    if (state == GPIO_HIGH)
+        host_pin[gpio_table[id].port] |=  gpio_table[id].mask;
+    else
+        host_pin[gpio_table[id].port] &= (uint8_t)~gpio_table[id].mask;
+}
+
+#endif /* MCU_TYPE */
+
 /* -------------------------------------------------------------------------- */
 /*                                GPIO INIT                                   */
 /* -------------------------------------------------------------------------- */
+/**
+ * @brief  Apply precomputed DDR/PORT masks of one port
+ *         port 가 상수 → 마스크/레지스터 주소 모두 상수로 접힘, 미사용 포트는 코드 0.
+ */
+static inline __attribute__((always_inline)) void gpioInitPort(uint8_t port)
+{
+    const uint8_t used   = GPIO_PORT_BYTE(GPIO_USED_BITS, port);
+    const uint8_t out    = GPIO_PORT_BYTE(GPIO_OUT_BITS, port);
+    const uint8_t pullup = GPIO_PORT_BYTE(GPIO_PULLUP_BITS, port);
+
+    if (!used) return;                                  // 미사용 포트는 건드리지 않음
+
+    *gpio_get_ddr(port) = (*gpio_get_ddr(port) & (uint8_t)~used) | out;   // output 1, input 0
+    if (pullup)
+        *gpio_get_port(port) |= pullup;                 // pull-up
+}
+
 /**
  * @brief  Initialize all GPIOs defined in gpio_table
- *         (논리 ID 기반 GPIO 초기화)
+ *         (논리 ID 기반 GPIO 초기화, 포트당 DDR 1회 + PORT 최대 1회)
  */
 void gpioInit(void)
 {
-    for (uint8_t i = 0; i < GPIO_MAX; i++)
-    {
-        volatile uint8_t *ddr = gpio_get_ddr(gpio_table[i].port);
-        if (!ddr) continue;
-
-        if (gpio_table[i].mode == GPIO_OUTPUT)
-            *ddr |=  (1 << gpio_table[i].pin);  // output
-        else
-            *ddr &= ~(1 << gpio_table[i].pin);  // input
-    }
+    gpioInitPort(PORT_A);
+    gpioInitPort(PORT_B);
+    gpioInitPort(PORT_C);
+    gpioInitPort(PORT_D);
+    gpioInitPort(PORT_E);
+    gpioInitPort(PORT_F);
+    gpioInitPort(PORT_G);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -109,13 +218,21 @@ void gpioInit(void)
  */
 void gpioWrite(gpio_id_t id, gpio_state_t state)
 {
-    volatile uint8_t *out = gpio_get_port(gpio_table[id].port);
+    volatile uint8_t *out;
+    uint8_t mask;
+
+    if (id >= GPIO_MAX) return;
+
+    out  = gpio_get_port(GPIO_RD(gpio_table[id].port));
+    mask = GPIO_RD(gpio_table[id].mask);
     if (!out) return;
 
+    GPIO_LOCK();
     if (state == GPIO_HIGH)
-        *out |=  (1 << gpio_table[id].pin);
+        *out |=  mask;
     else
-        *out &= ~(1 << gpio_table[id].pin);
+        *out &= (uint8_t)~mask;
+    GPIO_UNLOCK();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -126,10 +243,18 @@ void gpioWrite(gpio_id_t id, gpio_state_t state)
  */
 void gpioToggle(gpio_id_t id)
 {
-    volatile uint8_t *out = gpio_get_port(gpio_table[id].port);
+    volatile uint8_t *out;
+    uint8_t mask;
+
+    if (id >= GPIO_MAX) return;
+
+    out  = gpio_get_port(GPIO_RD(gpio_table[id].port));
+    mask = GPIO_RD(gpio_table[id].mask);
     if (!out) return;
 
-    *out ^= (1 << gpio_table[id].pin); // invert pin
+    GPIO_LOCK();
+    *out ^= mask;  // invert pin
+    GPIO_UNLOCK();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -141,10 +266,35 @@ void gpioToggle(gpio_id_t id)
  */
 uint8_t gpioRead(gpio_id_t id)
 {
-    volatile uint8_t *in = gpio_get_pin(gpio_table[id].port);
+    volatile uint8_t *in;
+
+    if (id >= GPIO_MAX) return 0;
+
+    in = gpio_get_pin(GPIO_RD(gpio_table[id].port));
     if (!in) return 0;
 
-    return (*in & (1 << gpio_table[id].pin)) ? 1 : 0;
+    return (*in & GPIO_RD(gpio_table[id].mask)) ? 1 : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                             GPIO REGISTER HANDLE                           */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief   Resolve logical GPIO to port registers + bit mask
+ *          (ISR / 포트 단위 일괄 처리 드라이버에서 1회 조회 후 캐시하여 사용)
+ * @return  false = 잘못된 ID 또는 포트
+ */
+bool gpioGetReg(gpio_id_t id, gpio_reg_t *p_reg)
+{
+    if (id >= GPIO_MAX || p_reg == NULL) return false;
+
+    p_reg->port = GPIO_RD(gpio_table[id].port);
+    p_reg->mask = GPIO_RD(gpio_table[id].mask);
+    p_reg->ddr  = gpio_get_ddr(p_reg->port);
+    p_reg->out  = gpio_get_port(p_reg->port);
+    p_reg->in   = gpio_get_pin(p_reg->port);
+
+    return (p_reg->ddr && p_reg->out && p_reg->in);
 }
 
-#endif /* MCU_ATMEGA128 */
+#endif /* MCU_ATMEGA128 || MCU_HOST */
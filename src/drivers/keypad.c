@@ -0,0 +1,257 @@
+/*
+ * File: keypad.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: Key matrix scanner
+ *              init 시 논리 GPIO → 레지스터/마스크를 캐시하고,
+ *              scan 은 캐시된 레지스터만 사용 (gpio_table 조회 없음).
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "keypad.h"
+#include "gpio.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL DEFINES                                */
+/* -------------------------------------------------------------------------- */
+#define KEYPAD_QUEUE_MASK   (KEYPAD_QUEUE_SIZE - 1)
+#define KEYPAD_COL_MASK     ((uint8_t)((1U << KEYPAD_COLS) - 1))
+
+#if (KEYPAD_ROWS < 1) || (KEYPAD_ROWS > 8) || (KEYPAD_COLS < 1) || (KEYPAD_COLS > 8)
+#error "KEYPAD_ROWS / KEYPAD_COLS must be 1 ~ 8"
+#endif
+
+#if (KEYPAD_QUEUE_SIZE & KEYPAD_QUEUE_MASK) || (KEYPAD_QUEUE_SIZE > 256)
+#error "KEYPAD_QUEUE_SIZE must be a power of 2 and <= 256"
+#endif
+
+/* 행 DDR RMW 보호: 같은 포트를 ISR 이 갱신해도 비트 손실 없음 */
+#if (MCU_TYPE == MCU_ATMEGA128)
+#define KEYPAD_LOCK()       uint8_t sreg = SREG; cli()
+#define KEYPAD_UNLOCK()     SREG = sreg
+#else
+#define KEYPAD_LOCK()       ((void)0)
+#define KEYPAD_UNLOCK()     ((void)0)
+#endif
+
+/* 행/열 논리 GPIO (app_config.h, 열은 같은 포트의 연속 핀, COL0 = 최하위) */
+#define KEYPAD_X_ID(id)     id,
+static const gpio_id_t kp_row_id[] = { APP_KEYPAD_ROWS(KEYPAD_X_ID) };
+static const gpio_id_t kp_col_id[] = { APP_KEYPAD_COLS(KEYPAD_X_ID) };
+#undef KEYPAD_X_ID
+
+_Static_assert(sizeof(kp_row_id) / sizeof(kp_row_id[0]) == KEYPAD_ROWS, "kp_row_id != KEYPAD_ROWS");
+_Static_assert(sizeof(kp_col_id) / sizeof(kp_col_id[0]) == KEYPAD_COLS, "kp_col_id != KEYPAD_COLS");
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL VARIABLES                              */
+/* -------------------------------------------------------------------------- */
+static volatile uint8_t *kp_row_ddr[KEYPAD_ROWS];   // 행 DDR (1 = Low 구동)
+static uint8_t           kp_row_mask[KEYPAD_ROWS];
+static volatile uint8_t *kp_col_in;                 // 열 PINx
+static uint8_t           kp_col_shift;              // COL0 비트 위치
+static bool              kp_ready;
+static uint8_t           kp_row;                    // 현재 구동 중인 행
+
+/* 행별 열 비트맵 (bit = 열, 1 = 눌림) */
+static uint8_t           kp_raw[KEYPAD_ROWS];       // 최근 sample
+static uint8_t           kp_state[KEYPAD_ROWS];     // debounce 결과
+static uint8_t           kp_report[KEYPAD_ROWS];    // 앱에 알린 상태
+static uint8_t           kp_ct0[KEYPAD_ROWS];       // vertical counter bit0
+static uint8_t           kp_ct1[KEYPAD_ROWS];       // vertical counter bit1
+
+static keypad_evt_t      kp_queue[KEYPAD_QUEUE_SIZE];
+static uint8_t           kp_head;
+static uint8_t           kp_tail;
+static uint8_t           kp_ghost_rows;             // 눌림 보류 중인 행 비트맵
+static uint16_t          kp_ghost_cnt;
+static uint16_t          kp_ovf;
+
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                             */
+/* -------------------------------------------------------------------------- */
+static inline void kpRowDrive(uint8_t row)
+{
+    KEYPAD_LOCK();
+    *kp_row_ddr[row] |= kp_row_mask[row];       // PORT = 0 → Low
+    KEYPAD_UNLOCK();
+}
+
+static inline void kpRowRelease(uint8_t row)
+{
+    KEYPAD_LOCK();
+    *kp_row_ddr[row] &= (uint8_t)~kp_row_mask[row];  // Hi-Z
+    KEYPAD_UNLOCK();
+}
+
+/**
+ * @brief  Ghost check: 두 행이 2개 이상 열을 공유하면 사각형의 4번째 키는
+ *         실제 눌림인지 구분 불가.
+ *         다른 행은 debounce 전 sample 도 포함 → 행별 debounce 완료 시점 차이로
+ *         ghost 가 먼저 보고되는 것을 막음.
+ */
+static bool kpIsGhost(uint8_t row)
+{
+    uint8_t s = kp_state[row] | kp_raw[row];
+
+    if (!(s & (s - 1))) return false;           // 1키 이하 → 사각형 불가
+
+    for (uint8_t j = 0; j < KEYPAD_ROWS; j++)
+    {
+        uint8_t x = s & (kp_state[j] | kp_raw[j]);
+
+        if (j != row && (x & (x - 1))) return true;
+    }
+    return false;
+}
+
+static void kpPush(uint8_t key, bool pressed)
+{
+    uint8_t next = (kp_head + 1) & KEYPAD_QUEUE_MASK;
+
+    if (next == kp_tail)
+    {
+        kp_ovf++;
+        return;
+    }
+
+    kp_queue[kp_head].key     = key;
+    kp_queue[kp_head].pressed = pressed;
+    kp_head = next;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 KEYPAD API                                 */
+/* -------------------------------------------------------------------------- */
+bool keypadInit(void)
+{
+    gpio_reg_t reg;
+    gpio_reg_t col0;
+
+    kp_ready = false;
+
+    if (!gpioGetReg(kp_col_id[0], &col0)) return false;
+    for (uint8_t c = 1; c < KEYPAD_COLS; c++)
+    {
+        if (!gpioGetReg(kp_col_id[c], &reg) || reg.port != col0.port ||
+            reg.mask != (uint8_t)(col0.mask << c))
+            return false;                       // 한 포트 연속 핀 아님
+    }
+
+    kp_col_in    = col0.in;
+    kp_col_shift = 0;
+    while (!(col0.mask & (1 << kp_col_shift))) kp_col_shift++;
+
+    for (uint8_t r = 0; r < KEYPAD_ROWS; r++)
+    {
+        if (!gpioGetReg(kp_row_id[r], &reg)) return false;
+
+        kp_row_ddr[r]  = reg.ddr;
+        kp_row_mask[r] = reg.mask;
+
+        KEYPAD_LOCK();
+        *reg.out &= (uint8_t)~reg.mask;         // 구동 시 Low, 대기 시 풀업 없는 Hi-Z
+        *reg.ddr &= (uint8_t)~reg.mask;
+        KEYPAD_UNLOCK();
+
+        kp_raw[r]    = 0;
+        kp_state[r]  = 0;
+        kp_report[r] = 0;
+        kp_ct0[r]    = 0xFF;                    // counter = 3 (첫 변화에서 바로 반전 방지)
+        kp_ct1[r]    = 0xFF;
+    }
+
+    kp_head       = kp_tail = 0;
+    kp_ghost_rows = 0;
+    kp_row        = 0;
+    kpRowDrive(0);                              // 첫 scan 까지 1ms 안정화
+    kp_ready = true;
+
+    return true;
+}
+
+/**
+ * @brief  Scan one row
+ *         1) 직전 tick 부터 구동된 행의 열 읽기 (안정화 1ms)
+ *         2) 다음 행 구동
+ *         3) vertical counter: 모든 열을 동시에 2bit 카운트, 4회 연속 다르면 반전
+ *         4) 보고 상태와 다른 비트만 이벤트 (뗌은 항상, 눌림은 ghost 아닐 때)
+ */
+void keypadScan(void)
+{
+    uint8_t row = kp_row;
+    uint8_t bit = (uint8_t)(1 << row);
+    uint8_t sample, delta, chg, rel, press;
+
+    if (!kp_ready) return;
+
+    sample = ((uint8_t)~*kp_col_in >> kp_col_shift) & KEYPAD_COL_MASK;    // Low = 눌림
+
+    kpRowRelease(row);
+    kp_row = (row + 1 < KEYPAD_ROWS) ? (uint8_t)(row + 1) : 0;
+    kpRowDrive(kp_row);
+
+    kp_raw[row] = sample;
+
+    delta        = kp_state[row] ^ sample;
+    kp_ct0[row]  = ~(kp_ct0[row] & delta);
+    kp_ct1[row]  = kp_ct0[row] ^ (kp_ct1[row] & delta);
+    delta       &= kp_ct0[row] & kp_ct1[row];
+    kp_state[row] ^= delta;
+
+    chg   = kp_state[row] ^ kp_report[row];
+    rel   = chg & kp_report[row];
+    press = chg & kp_state[row];
+
+    if (press && kpIsGhost(row))
+    {
+        press = 0;                              // 모호 → 해소될 때까지 보류
+        if (!(kp_ghost_rows & bit)) kp_ghost_cnt++;
+        kp_ghost_rows |= bit;
+    }
+    else
+    {
+        kp_ghost_rows &= (uint8_t)~bit;
+    }
+
+    chg = rel | press;
+    kp_report[row] ^= chg;
+
+    for (uint8_t c = 0; chg; c++, chg >>= 1)
+    {
+        if (chg & 1)
+            kpPush(KEYPAD_KEY(row, c), (press >> c) & 1);
+    }
+}
+
+bool keypadRead(keypad_evt_t *p_evt)
+{
+    if (p_evt == NULL || kp_head == kp_tail) return false;
+
+    *p_evt  = kp_queue[kp_tail];
+    kp_tail = (kp_tail + 1) & KEYPAD_QUEUE_MASK;
+
+    return true;
+}
+
+bool keypadIsPressed(uint8_t key)
+{
+    if (key >= KEYPAD_ROWS * KEYPAD_COLS) return false;
+
+    return (kp_report[key / KEYPAD_COLS] >> (key % KEYPAD_COLS)) & 1;
+}
+
+uint16_t keypadGetGhostCount(void)
+{
+    return kp_ghost_cnt;
+}
+
+uint16_t keypadGetOverflow(void)
+{
+    return kp_ovf;
+}
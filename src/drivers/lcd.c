@@ -0,0 +1,271 @@
+/*
+ * File: lcd.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: Non-blocking HD44780 character LCD driver (4bit, write-only)
+ *              framebuffer(lcd_fb) 와 LCD 실제 내용(lcd_shadow)을 비교하여
+ *              다른 셀만 1ms 당 1바이트씩 전송한다.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "lcd.h"
+#include "gpio.h"
+#include "delay.h"        // micros()
+#include "soft_timer.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL DEFINES                                */
+/* -------------------------------------------------------------------------- */
+#define LCD_CELLS           (LCD_ROWS * LCD_COLS)
+#define LCD_ADDR_NONE       0xFF        // LCD 주소 카운터 위치 모름 → set-address 필요
+#define LCD_POWER_MS        50          // 전원 인가 후 대기 (datasheet ≥ 40ms)
+
+#if (LCD_ROWS < 1) || (LCD_ROWS > 4) || (LCD_COLS > 40) || (LCD_CELLS > 80)
+#error "LCD_ROWS must be 1~4 and LCD_ROWS x LCD_COLS <= 80"
+#endif
+
+/* HD44780 commands */
+#define LCD_CMD_CLEAR       0x01
+#define LCD_CMD_ENTRY_INC   0x06        // 주소 자동 증가, shift 없음
+#define LCD_CMD_DISP_OFF    0x08
+#define LCD_CMD_DISP_ON     0x0C        // display on, cursor/blink off
+#define LCD_CMD_FUNC_4BIT   ((LCD_ROWS > 1) ? 0x28 : 0x20)  // 4bit, N lines, 5x8
+#define LCD_CMD_SET_DDRAM   0x80
+
+typedef enum
+{
+    LCD_ST_OFF = 0,      // lcdInit() 전
+    LCD_ST_INIT,         // 초기화 시퀀스 진행 중
+    LCD_ST_RUN           // framebuffer 반영
+} lcd_state_t;
+
+typedef struct
+{
+    uint8_t cmd;         // 명령 (nibble 단계는 하위 4bit)
+    uint8_t nibble;      // 1 = 상위 nibble 만 전송 (8bit → 4bit 전환 단계)
+    uint8_t wait_ms;     // 다음 단계까지 대기 [ms], 0 = 다음 tick
+} lcd_init_step_t;
+
+/* 4bit 초기화 시퀀스 (HD44780 datasheet Figure 24) */
+static const lcd_init_step_t lcd_init_seq[] =
+{
+    { 0x03,              1, 5 },   // function set (8bit) 1회차, > 4.1ms
+    { 0x03,              1, 1 },   // 2회차, > 100µs
+    { 0x03,              1, 0 },   // 3회차
+    { 0x02,              1, 0 },   // 4bit 모드 진입
+    { 0x00,              0, 0 },   // (LCD_CMD_FUNC_4BIT, 런타임 치환)
+    { LCD_CMD_DISP_OFF,  0, 0 },
+    { LCD_CMD_CLEAR,     0, 2 },   // clear, 1.52ms
+    { LCD_CMD_ENTRY_INC, 0, 0 },
+    { LCD_CMD_DISP_ON,   0, 0 },
+};
+
+#define LCD_INIT_STEPS      (sizeof(lcd_init_seq) / sizeof(lcd_init_seq[0]))
+#define LCD_INIT_FUNC_STEP  4
+
+/* 행 시작 DDRAM 주소 (16x4, 20x4 공통: 3/4행은 1/2행 뒤에 이어짐) */
+static const uint8_t lcd_row_addr[4] = { 0x00, 0x40, LCD_COLS, 0x40 + LCD_COLS };
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL VARIABLES                              */
+/* -------------------------------------------------------------------------- */
+static char         lcd_fb[LCD_CELLS];       // 애플리케이션 framebuffer
+static char         lcd_shadow[LCD_CELLS];   // LCD DDRAM 에 실제 기록된 내용
+static uint8_t      lcd_cur;                 // framebuffer 쓰기 위치 (셀 index)
+static uint8_t      lcd_addr;                // LCD 주소 카운터가 가리키는 셀
+static lcd_state_t  lcd_state;
+static uint8_t      lcd_step;                // 초기화 단계
+static soft_timer_t lcd_tmr;                 // ms 단위 대기
+static uint32_t     lcd_last_us;             // 마지막 전송 시각 (명령 실행 시간 보장)
+
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Put nibble on D4~D7 and strobe E (E pulse ≥ 230ns, gpioWrite 1회로 충족)
+ */
+static void lcdWriteNibble(uint8_t nibble)
+{
+    gpioWrite(GPIO_LCD_D4, (nibble & 0x01) ? GPIO_HIGH : GPIO_LOW);
+    gpioWrite(GPIO_LCD_D5, (nibble & 0x02) ? GPIO_HIGH : GPIO_LOW);
+    gpioWrite(GPIO_LCD_D6, (nibble & 0x04) ? GPIO_HIGH : GPIO_LOW);
+    gpioWrite(GPIO_LCD_D7, (nibble & 0x08) ? GPIO_HIGH : GPIO_LOW);
+
+    gpioWrite(GPIO_LCD_E, GPIO_HIGH);
+    gpioWrite(GPIO_LCD_E, GPIO_LOW);        // falling edge 에서 latch
+}
+
+/**
+ * @brief  Send command (rs = 0) or data (rs = 1) byte
+ */
+static void lcdWriteByte(uint8_t rs, uint8_t value)
+{
+    gpioWrite(GPIO_LCD_RS, rs ? GPIO_HIGH : GPIO_LOW);
+    lcdWriteNibble(value >> 4);
+    lcdWriteNibble(value & 0x0F);
+
+    lcd_last_us = micros();
+}
+
+/**
+ * @brief  One init step, 완료 시 RUN 상태로 전환
+ */
+static void lcdInitStep(void)
+{
+    const lcd_init_step_t *p_step = &lcd_init_seq[lcd_step];
+
+    if (p_step->nibble)
+    {
+        gpioWrite(GPIO_LCD_RS, GPIO_LOW);
+        lcdWriteNibble(p_step->cmd);
+        lcd_last_us = micros();
+    }
+    else
+    {
+        lcdWriteByte(0, (lcd_step == LCD_INIT_FUNC_STEP) ? LCD_CMD_FUNC_4BIT : p_step->cmd);
+    }
+
+    // millis() 분해능이 1ms 이므로 +1 해야 최소 대기 보장
+    softTimerStart(&lcd_tmr, p_step->wait_ms ? (p_step->wait_ms + 1) : 0);
+
+    if (++lcd_step >= LCD_INIT_STEPS)
+    {
+        memset(lcd_shadow, ' ', sizeof(lcd_shadow));   // clear 후 DDRAM = 공백
+        lcd_addr  = 0;                                  // clear 후 주소 = 0
+        lcd_state = LCD_ST_RUN;
+    }
+}
+
+/**
+ * @brief  Push one changed cell
+ *         LCD 주소 카운터 위치부터 검색 → 연속된 변경 셀은 set-address 없이 전송.
+ *         주소가 다르면 이번 tick 은 set-address 만, 데이터는 다음 tick.
+ */
+static void lcdRefreshStep(void)
+{
+    uint8_t cell = (lcd_addr < LCD_CELLS) ? lcd_addr : 0;
+
+    for (uint8_t n = 0; n < LCD_CELLS; n++)
+    {
+        if (lcd_fb[cell] != lcd_shadow[cell])
+        {
+            uint8_t row = cell / LCD_COLS;
+            uint8_t col = cell - (row * LCD_COLS);
+
+            if (lcd_addr != cell)
+            {
+                lcdWriteByte(0, LCD_CMD_SET_DDRAM | (lcd_row_addr[row] + col));
+                lcd_addr = cell;
+                return;
+            }
+
+            lcdWriteByte(1, (uint8_t)lcd_fb[cell]);
+            lcd_shadow[cell] = lcd_fb[cell];
+
+            // 행 끝 다음 DDRAM 주소는 다음 행 시작이 아님
+            lcd_addr = (col == LCD_COLS - 1) ? LCD_ADDR_NONE : cell + 1;
+            return;
+        }
+
+        if (++cell >= LCD_CELLS) cell = 0;
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LCD STATE MACHINE                            */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Start LCD initialization (non-blocking)
+ */
+void lcdInit(void)
+{
+    gpioWrite(GPIO_LCD_E, GPIO_LOW);
+    gpioWrite(GPIO_LCD_RS, GPIO_LOW);
+
+    memset(lcd_fb, ' ', sizeof(lcd_fb));
+    lcd_cur     = 0;
+    lcd_addr    = LCD_ADDR_NONE;
+    lcd_step    = 0;
+    lcd_last_us = micros();
+    lcd_state   = LCD_ST_INIT;
+
+    softTimerStart(&lcd_tmr, LCD_POWER_MS);
+}
+
+/**
+ * @brief  LCD state machine step (1ms 주기)
+ *         task 호출 간격이 1ms 보다 짧아질 수 있으므로 LCD_CMD_US 도 확인.
+ */
+void lcdUpdate(void)
+{
+    if (lcd_state == LCD_ST_OFF) return;
+    if (!softTimerIsElapsed(&lcd_tmr)) return;
+    if ((micros() - lcd_last_us) < LCD_CMD_US) return;
+
+    if (lcd_state == LCD_ST_INIT)
+        lcdInitStep();
+    else
+        lcdRefreshStep();
+}
+
+bool lcdIsReady(void)
+{
+    return (lcd_state == LCD_ST_RUN);
+}
+
+bool lcdIsSynced(void)
+{
+    return (lcd_state == LCD_ST_RUN) && (memcmp(lcd_fb, lcd_shadow, LCD_CELLS) == 0);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                              FRAMEBUFFER API                               */
+/* -------------------------------------------------------------------------- */
+void lcdClear(void)
+{
+    memset(lcd_fb, ' ', sizeof(lcd_fb));
+    lcd_cur = 0;
+}
+
+void lcdSetCursor(uint8_t col, uint8_t row)
+{
+    if (col >= LCD_COLS) col = LCD_COLS - 1;
+    if (row >= LCD_ROWS) row = LCD_ROWS - 1;
+
+    lcd_cur = (row * LCD_COLS) + col;
+}
+
+void lcdPrint(const char *str)
+{
+    uint8_t row_end;
+
+    if (str == NULL) return;
+
+    row_end = ((lcd_cur / LCD_COLS) + 1) * LCD_COLS;
+
+    while (*str && lcd_cur < row_end)
+    {
+        lcd_fb[lcd_cur++] = *str++;
+    }
+
+    if (lcd_cur >= row_end) lcd_cur = row_end - 1;     // 줄 끝에 고정
+}
+
+void lcdPrintAt(uint8_t col, uint8_t row, const char *str)
+{
+    lcdSetCursor(col, row);
+    lcdPrint(str);
+}
+
+void lcdWriteFrame(const char *frame)
+{
+    if (frame == NULL) return;
+
+    memcpy(lcd_fb, frame, LCD_CELLS);
+}
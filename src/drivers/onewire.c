@@ -0,0 +1,669 @@
+/*
+ * File: onewire.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: Timer-driven 1-Wire bus master + DS18B20 operation queue
+ *              - Bus engine (ISR)  : Timer0 CTC compare 마다 slot 한 단계 진행
+ *                                    reset → presence → tx bits → rx bits / search
+ *              - Operation (task)  : 큐에서 동작을 꺼내 트랜잭션 구성, 완료 시
+ *                                    CRC/온도 처리, 변환 대기는 soft_timer
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "onewire.h"
+#include "gpio.h"
+#include "soft_timer.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               LOCAL DEFINES                                */
+/* -------------------------------------------------------------------------- */
+#define OW_QUEUE_MASK       (ONEWIRE_QUEUE_SIZE - 1)
+
+#if (ONEWIRE_QUEUE_SIZE & OW_QUEUE_MASK) || (ONEWIRE_QUEUE_SIZE > 256)
+#error "ONEWIRE_QUEUE_SIZE must be a power of 2 and <= 256"
+#endif
+
+/* ROM / function commands */
+#define OW_CMD_SEARCH_ROM   0xF0
+#define OW_CMD_MATCH_ROM    0x55
+#define OW_CMD_SKIP_ROM     0xCC
+#define OW_CMD_CONVERT_T    0x44
+#define OW_CMD_READ_SCRATCH 0xBE
+
+#define OW_ROM_LEN          8
+#define OW_SCRATCH_LEN      9
+#define OW_TX_MAX           (1 + OW_ROM_LEN + 1)    // match ROM + ROM + function
+
+typedef enum
+{
+    OW_OP_SEARCH = 0,
+    OW_OP_CONVERT,
+    OW_OP_READ
+} ow_op_t;
+
+typedef enum
+{
+    OW_STG_IDLE = 0,     // 다음 동작 대기
+    OW_STG_BUS,          // 버스 트랜잭션 진행 중 (ISR)
+    OW_STG_WAIT          // 변환 대기 (soft_timer)
+} ow_stage_t;
+
+typedef struct
+{
+    uint8_t op;          // ow_op_t
+    uint8_t dev;         // 디바이스 index / ONEWIRE_DEV_ALL
+} ow_req_t;
+
+
+/* -------------------------------------------------------------------------- */
+/*                           TRANSACTION (ISR SHARED)                         */
+/* -------------------------------------------------------------------------- */
+/* task 가 ow_busy = false 일 때만 설정, ISR 은 ow_busy = true 동안만 접근 */
+static uint8_t          ow_tx[OW_TX_MAX];           // 송신 바이트 (LSB first)
+static uint8_t          ow_tx_bits;                 // 송신 bit 수
+static uint8_t          ow_rx[OW_SCRATCH_LEN];      // 수신 바이트
+static uint8_t          ow_rx_bits;                 // 수신 bit 수
+static uint8_t          ow_bit;                     // 진행 중 bit index (tx → rx)
+static bool             ow_search;                  // tx 이후 search triplet 64회
+static volatile bool    ow_busy;                    // 트랜잭션 진행 중
+static volatile bool    ow_presence;                // reset 응답 여부
+
+/* ROM search (Maxim AN187) */
+static uint8_t          ow_srch_rom[OW_ROM_LEN];    // 이번 pass ROM
+static uint8_t          ow_srch_bit;                // 1 ~ 64, 65 = 종료
+static uint8_t          ow_srch_step;               // 0: id bit, 1: 보수 bit, 2: 방향 write
+static uint8_t          ow_srch_last_zero;          // 이번 pass 마지막 0 선택 위치
+static uint8_t          ow_srch_last_disc;          // 이전 pass discrepancy
+static bool             ow_srch_fail;               // id = 보수 = 1 (응답 없음)
+
+
+/* -------------------------------------------------------------------------- */
+/*                            OPERATION (TASK ONLY)                           */
+/* -------------------------------------------------------------------------- */
+static bool             ow_ready;                   // onewireInit() 성공
+static ow_req_t         ow_queue[ONEWIRE_QUEUE_SIZE];
+static uint8_t          ow_q_head;
+static uint8_t          ow_q_tail;
+static ow_req_t         ow_cur;                     // 진행 중 동작
+static ow_stage_t       ow_stage;
+static soft_timer_t     ow_tmr;                     // 변환 대기
+
+static uint8_t          ow_rom[ONEWIRE_DEV_MAX][OW_ROM_LEN];
+static uint8_t          ow_dev_count;
+static int16_t          ow_temp[ONEWIRE_DEV_MAX];   // [0.01°C]
+static uint16_t         ow_err;
+
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+/* -------------------------------------------------------------------------- */
+/*                            BUS ENGINE (TIMER0)                             */
+/* -------------------------------------------------------------------------- */
+/*
+ * Slot timing [µs] (Maxim AN126 기준, ISR 진입 지연 고려):
+ *   - 15µs 이내가 중요한 구간(write-1 LOW, read 샘플)은 ISR 안에서 직접 생성
+ *     → 인터럽트 금지 상태라 다른 ISR 지연과 무관하게 정확.
+ *   - 긴 구간(reset, write-0 LOW, slot 나머지)은 Timer0 compare 로 대기.
+ */
+#define OW_T_RSTL           480     // reset LOW
+#define OW_T_PDS            70      // release → presence 샘플
+#define OW_T_RSTH           410     // presence 샘플 → 첫 slot
+#define OW_T_LOW1           3       // write-1 / read LOW (ISR 내)
+#define OW_T_RDS            7       // read: release → 샘플 (LOW 시작 후 약 10µs + ISR 지연)
+#define OW_T_SLOT1          62      // write-1: release → 다음 slot
+#define OW_T_LOW0           60      // write-0 LOW
+#define OW_T_REC            5       // write-0: release → 다음 slot
+#define OW_T_RSLOT          55      // read: 샘플 → 다음 slot
+
+typedef enum
+{
+    OW_PH_RESET_LOW = 0, // reset LOW 종료 대기
+    OW_PH_PRESENCE,      // presence 샘플 대기
+    OW_PH_RESET_END,     // reset 종료 → 첫 slot
+    OW_PH_WRITE0_LOW,    // write-0 LOW 종료 대기
+    OW_PH_SLOT_END       // slot 종료 → 다음 slot
+} ow_phase_t;
+
+static gpio_reg_t       ow_reg;                     // GPIO_OW_DQ 레지스터 캐시
+static uint8_t          ow_phase;
+static uint8_t          ow_srch_id;                 // search: 읽은 id bit
+static uint8_t          ow_srch_dir;                // search: 선택한 방향
+
+/* open-drain: PORT bit = 0 고정, DDR 로 LOW 구동 / 해제(풀업) */
+#define OW_BUS_LOW()        (*ow_reg.ddr |=  ow_reg.mask)
+#define OW_BUS_RELEASE()    (*ow_reg.ddr &= ~ow_reg.mask)
+#define OW_BUS_READ()       ((*ow_reg.in & ow_reg.mask) ? 1 : 0)
+
+/**
+ * @brief  Fire TIMER0_COMP after us (CTC, 상수 인자 → 컴파일 타임 계산)
+ *         ≤ 100µs : clk/8  (0.5µs @16MHz)
+ *         > 100µs : clk/64 (4µs @16MHz)
+ */
+static inline __attribute__((always_inline)) void owSchedule(uint16_t us)
+{
+    TCCR0 = (1 << WGM01);                           // 정지
+    TCNT0 = 0;
+    if (us > 100)
+    {
+        OCR0  = (uint8_t)((us * (F_CPU / 1000000UL)) / 64 - 1);
+        TIFR  = (1 << OCF0);
+        SFIOR |= (1 << PSR0);                       // prescaler 위상 초기화
+        TCCR0 = (1 << WGM01) | (1 << CS02);         // clk/64
+    }
+    else
+    {
+        OCR0  = (uint8_t)((us * (F_CPU / 1000000UL)) / 8 - 1);
+        TIFR  = (1 << OCF0);
+        SFIOR |= (1 << PSR0);
+        TCCR0 = (1 << WGM01) | (1 << CS01);         // clk/8
+    }
+}
+
+static void owStop(void)
+{
+    TCCR0  = (1 << WGM01);                          // CTC 유지 (Timer0 점유 표시), clock 정지
+    TIMSK &= ~(1 << OCIE0);
+    ow_busy = false;
+}
+
+static inline __attribute__((always_inline)) void owSlotWrite(uint8_t bit)
+{
+    OW_BUS_LOW();
+    if (bit)
+    {
+        _delay_us(OW_T_LOW1);
+        OW_BUS_RELEASE();
+        owSchedule(OW_T_SLOT1);
+        ow_phase = OW_PH_SLOT_END;
+    }
+    else
+    {
+        owSchedule(OW_T_LOW0);
+        ow_phase = OW_PH_WRITE0_LOW;
+    }
+}
+
+static inline __attribute__((always_inline)) uint8_t owSlotRead(void)
+{
+    uint8_t bit;
+
+    OW_BUS_LOW();
+    _delay_us(OW_T_LOW1);
+    OW_BUS_RELEASE();
+    _delay_us(OW_T_RDS);
+    bit = OW_BUS_READ();
+
+    owSchedule(OW_T_RSLOT);
+    ow_phase = OW_PH_SLOT_END;
+
+    return bit;
+}
+
+/**
+ * @brief  One search triplet step (id bit → 보수 bit → 방향 write)
+ * @return false = search 종료 (slot 시작 안 함)
+ */
+static inline __attribute__((always_inline)) bool owSearchSlot(void)
+{
+    uint8_t idx  = ow_srch_bit - 1;
+    uint8_t mask = (uint8_t)(1 << (idx & 7));
+
+    if (ow_srch_bit > 64) return false;
+
+    if (ow_srch_step == 0)
+    {
+        ow_srch_id   = owSlotRead();
+        ow_srch_step = 1;
+    }
+    else if (ow_srch_step == 1)
+    {
+        uint8_t cmp = owSlotRead();
+
+        if (ow_srch_id && cmp)                      // 응답 디바이스 없음
+        {
+            ow_srch_fail = true;
+            ow_srch_bit  = 65;
+            return true;
+        }
+
+        if (ow_srch_id != cmp)
+        {
+            ow_srch_dir = ow_srch_id;               // 모든 디바이스 같은 bit
+        }
+        else
+        {
+            // discrepancy: 이전 pass 이전 위치는 같은 방향, 그 위치는 1, 이후는 0
+            if (ow_srch_bit < ow_srch_last_disc)
+                ow_srch_dir = (ow_srch_rom[idx >> 3] & mask) ? 1 : 0;
+            else
+                ow_srch_dir = (ow_srch_bit == ow_srch_last_disc) ? 1 : 0;
+
+            if (ow_srch_dir == 0)
+                ow_srch_last_zero = ow_srch_bit;
+        }
+
+        if (ow_srch_dir) ow_srch_rom[idx >> 3] |=  mask;
+        else             ow_srch_rom[idx >> 3] &= ~mask;
+        ow_srch_step = 2;
+    }
+    else
+    {
+        owSlotWrite(ow_srch_dir);
+        ow_srch_step = 0;
+        ow_srch_bit++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  Start next slot of transaction (tx → rx → search), 없으면 종료
+ */
+static inline __attribute__((always_inline)) void owNextSlot(void)
+{
+    uint8_t n = ow_bit;
+
+    if (n < ow_tx_bits)
+    {
+        owSlotWrite((ow_tx[n >> 3] >> (n & 7)) & 1);
+        ow_bit++;
+        return;
+    }
+
+    n -= ow_tx_bits;
+    if (n < ow_rx_bits)
+    {
+        if (owSlotRead())
+            ow_rx[n >> 3] |= (uint8_t)(1 << (n & 7));
+        ow_bit++;
+        return;
+    }
+
+    if (ow_search && owSearchSlot()) return;
+
+    owStop();
+}
+
+/**
+ * @brief  Timer0 compare → slot 단계 진행
+ */
+ISR(TIMER0_COMP_vect)
+{
+    switch (ow_phase)
+    {
+        case OW_PH_RESET_LOW:
+            OW_BUS_RELEASE();
+            owSchedule(OW_T_PDS);
+            ow_phase = OW_PH_PRESENCE;
+            break;
+
+        case OW_PH_PRESENCE:
+            ow_presence = !OW_BUS_READ();           // 디바이스가 LOW 로 응답
+            owSchedule(OW_T_RSTH);
+            ow_phase = OW_PH_RESET_END;
+            break;
+
+        case OW_PH_RESET_END:
+            if (ow_presence) owNextSlot();
+            else             owStop();
+            break;
+
+        case OW_PH_WRITE0_LOW:
+            OW_BUS_RELEASE();
+            owSchedule(OW_T_REC);
+            ow_phase = OW_PH_SLOT_END;
+            break;
+
+        default:
+            owNextSlot();
+            break;
+    }
+}
+
+/**
+ * @brief  Start transaction (reset 부터), ow_tx/ow_rx_bits/ow_search 설정 후 호출
+ */
+static void owBusStart(void)
+{
+    uint8_t sreg = SREG;
+
+    cli();
+    ow_busy     = true;
+    ow_presence = false;
+    OW_BUS_LOW();
+    owSchedule(OW_T_RSTL);
+    ow_phase = OW_PH_RESET_LOW;
+    TIMSK |= (1 << OCIE0);
+    SREG = sreg;
+}
+
+/**
+ * @brief  Transaction 진행 여부 (cli 가 memory barrier → 이후 결과 읽기 순서 보장)
+ */
+static bool owBusBusy(void)
+{
+    uint8_t sreg = SREG;
+    bool    busy;
+
+    cli();
+    busy = ow_busy;
+    SREG = sreg;
+
+    return busy;
+}
+
+static bool owBusInit(void)
+{
+    if (TCCR0 & (1 << WGM00)) return false;         // Timer0 = PWM_HW_OC0
+    if (!gpioGetReg(GPIO_OW_DQ, &ow_reg)) return false;
+
+    *ow_reg.out &= ~ow_reg.mask;                    // LOW 구동 준비 (풀업 off)
+    OW_BUS_RELEASE();
+
+    TCCR0  = (1 << WGM01);                          // CTC, clock 정지
+    TIMSK &= ~(1 << OCIE0);
+    return true;
+}
+
+#else
+/* -------------------------------------------------------------------------- */
+/*                          BUS ENGINE (NOT SUPPORTED)                        */
+/* -------------------------------------------------------------------------- */
+/* Timer 기반 slot 생성이 없는 backend: 버스 없음 → onewireInit() = false */
+static void owBusStart(void)
+{
+    ow_presence = false;
+    ow_busy     = false;
+}
+
+static bool owBusBusy(void)
+{
+    return ow_busy;
+}
+
+static bool owBusInit(void)
+{
+    return false;
+}
+#endif /* MCU_TYPE */
+
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                             */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Dallas/Maxim CRC8 (x^8 + x^5 + x^4 + 1), 데이터+CRC 전체 → 0 이면 정상
+ */
+static uint8_t owCrc8(const uint8_t *p_data, uint8_t len)
+{
+    uint8_t crc = 0;
+
+    while (len--)
+    {
+        uint8_t b = *p_data++;
+
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            uint8_t mix = (crc ^ b) & 0x01;
+            crc >>= 1;
+            if (mix) crc ^= 0x8C;
+            b >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief  Build tx = [Skip ROM | Match ROM + ROM] + cmd
+ */
+static void owSetTx(uint8_t dev, uint8_t cmd)
+{
+    uint8_t len = 0;
+
+    if (dev == ONEWIRE_DEV_ALL)
+    {
+        ow_tx[len++] = OW_CMD_SKIP_ROM;
+    }
+    else
+    {
+        ow_tx[len++] = OW_CMD_MATCH_ROM;
+        memcpy(&ow_tx[len], ow_rom[dev], OW_ROM_LEN);
+        len += OW_ROM_LEN;
+    }
+    ow_tx[len++] = cmd;
+
+    ow_tx_bits = len * 8;
+    ow_rx_bits = 0;
+    ow_search  = false;
+    ow_bit     = 0;
+}
+
+static void owStartSearchPass(void)
+{
+    ow_tx[0]          = OW_CMD_SEARCH_ROM;
+    ow_tx_bits        = 8;
+    ow_rx_bits        = 0;
+    ow_search         = true;
+    ow_bit            = 0;
+    ow_srch_bit       = 1;
+    ow_srch_step      = 0;
+    ow_srch_last_zero = 0;
+    ow_srch_fail      = false;
+
+    owBusStart();
+}
+
+/**
+ * @brief  Start dequeued operation
+ * @return false = 실행할 것 없음 (잘못된 디바이스)
+ */
+static bool owBegin(void)
+{
+    switch (ow_cur.op)
+    {
+        case OW_OP_SEARCH:
+            ow_dev_count      = 0;
+            ow_srch_last_disc = 0;
+            memset(ow_srch_rom, 0, sizeof(ow_srch_rom));
+            owStartSearchPass();
+            return true;
+
+        case OW_OP_CONVERT:
+            if (ow_cur.dev != ONEWIRE_DEV_ALL && ow_cur.dev >= ow_dev_count) return false;
+            owSetTx(ow_cur.dev, OW_CMD_CONVERT_T);
+            owBusStart();
+            return true;
+
+        case OW_OP_READ:
+            if (ow_cur.dev >= ow_dev_count) return false;
+            owSetTx(ow_cur.dev, OW_CMD_READ_SCRATCH);
+            ow_rx_bits = OW_SCRATCH_LEN * 8;
+            memset(ow_rx, 0, sizeof(ow_rx));
+            owBusStart();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief  Post-process finished transaction
+ * @return 다음 stage
+ */
+static ow_stage_t owFinish(void)
+{
+    if (!ow_presence)
+    {
+        ow_err++;
+        return OW_STG_IDLE;
+    }
+
+    switch (ow_cur.op)
+    {
+        case OW_OP_SEARCH:
+            if (ow_srch_fail) return OW_STG_IDLE;
+
+            if (owCrc8(ow_srch_rom, OW_ROM_LEN) == 0)
+                memcpy(ow_rom[ow_dev_count++], ow_srch_rom, OW_ROM_LEN);
+            else
+                ow_err++;
+
+            ow_srch_last_disc = ow_srch_last_zero;
+            if (ow_srch_last_disc == 0 || ow_dev_count >= ONEWIRE_DEV_MAX)
+                return OW_STG_IDLE;                 // 마지막 디바이스
+
+            owStartSearchPass();
+            return OW_STG_BUS;
+
+        case OW_OP_CONVERT:
+            // millis() 분해능 보정 +1
+            softTimerStart(&ow_tmr, ONEWIRE_CONVERT_MS + 1);
+            return OW_STG_WAIT;
+
+        case OW_OP_READ:
+            // CRC + config 레지스터 고정 bit 확인 (bit7 = 0, bit0~4 = 1) → 전부 0 응답 제외
+            if (owCrc8(ow_rx, OW_SCRATCH_LEN) == 0 && (ow_rx[4] & 0x9F) == 0x1F)
+            {
+                int16_t raw = (int16_t)(((uint16_t)ow_rx[1] << 8) | ow_rx[0]);   // [1/16°C]
+                ow_temp[ow_cur.dev] = (int16_t)(((int32_t)raw * 25) / 4);      // [0.01°C]
+            }
+            else
+            {
+                ow_err++;
+            }
+            return OW_STG_IDLE;
+
+        default:
+            return OW_STG_IDLE;
+    }
+}
+
+static bool owPush(uint8_t op, uint8_t dev)
+{
+    uint8_t next = (ow_q_head + 1) & OW_QUEUE_MASK;
+
+    if (!ow_ready || next == ow_q_tail) return false;
+
+    ow_queue[ow_q_head].op  = op;
+    ow_queue[ow_q_head].dev = dev;
+    ow_q_head = next;
+
+    return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                ONEWIRE API                                 */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Initialize 1-Wire master
+ */
+bool onewireInit(void)
+{
+    ow_ready     = false;
+    ow_busy      = false;
+    ow_stage     = OW_STG_IDLE;
+    ow_q_head    = 0;
+    ow_q_tail    = 0;
+    ow_dev_count = 0;
+    ow_err       = 0;
+
+    for (uint8_t i = 0; i < ONEWIRE_DEV_MAX; i++)
+        ow_temp[i] = ONEWIRE_TEMP_INVALID;
+
+    ow_ready = owBusInit();
+    return ow_ready;
+}
+
+bool onewireQueueSearch(void)
+{
+    return owPush(OW_OP_SEARCH, 0);
+}
+
+bool onewireQueueConvert(uint8_t dev)
+{
+    if (dev != ONEWIRE_DEV_ALL && dev >= ONEWIRE_DEV_MAX) return false;
+
+    return owPush(OW_OP_CONVERT, dev);
+}
+
+bool onewireQueueRead(uint8_t dev)
+{
+    if (dev >= ONEWIRE_DEV_MAX) return false;
+
+    return owPush(OW_OP_READ, dev);
+}
+
+bool onewireQueueReadAll(void)
+{
+    uint8_t used = (ow_q_head - ow_q_tail) & OW_QUEUE_MASK;
+    uint8_t free = (ONEWIRE_QUEUE_SIZE - 1) - used;
+
+    if (!ow_ready || free < (uint8_t)(ow_dev_count + 1)) return false;
+
+    owPush(OW_OP_CONVERT, ONEWIRE_DEV_ALL);         // 모든 센서 동시 변환 → 750ms 1회
+    for (uint8_t i = 0; i < ow_dev_count; i++)
+        owPush(OW_OP_READ, i);
+
+    return true;
+}
+
+/**
+ * @brief  Operation state machine (1ms task)
+ */
+void onewireUpdate(void)
+{
+    if (!ow_ready || owBusBusy()) return;           // ISR 트랜잭션 진행 중
+
+    if (ow_stage == OW_STG_BUS)
+    {
+        ow_stage = owFinish();
+    }
+    else if (ow_stage == OW_STG_WAIT)
+    {
+        if (softTimerIsElapsed(&ow_tmr))
+            ow_stage = OW_STG_IDLE;
+    }
+
+    while (ow_stage == OW_STG_IDLE && ow_q_tail != ow_q_head)
+    {
+        ow_cur    = ow_queue[ow_q_tail];
+        ow_q_tail = (ow_q_tail + 1) & OW_QUEUE_MASK;
+
+        if (owBegin())
+            ow_stage = OW_STG_BUS;
+    }
+}
+
+bool onewireIsBusy(void)
+{
+    return (ow_stage != OW_STG_IDLE) || (ow_q_tail != ow_q_head);
+}
+
+uint8_t onewireGetCount(void)
+{
+    return ow_dev_count;
+}
+
+bool onewireGetRom(uint8_t dev, uint8_t *p_rom)
+{
+    if (dev >= ow_dev_count || p_rom == NULL) return false;
+
+    memcpy(p_rom, ow_rom[dev], OW_ROM_LEN);
+    return true;
+}
+
+int16_t onewireGetTemp(uint8_t dev)
+{
+    if (dev >= ONEWIRE_DEV_MAX) return ONEWIRE_TEMP_INVALID;
+
+    return ow_temp[dev];
+}
+
+uint16_t onewireGetErrCount(void)
+{
+    return ow_err;
+}
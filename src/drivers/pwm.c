@@ -0,0 +1,483 @@
+/*
+ * File: pwm.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: ATmega128 multi-channel PWM engine
+ *              - Hardware PWM : Timer0/2 (8bit), Timer3 (16bit) phase correct
+ *              - Software PWM : Timer2 overflow = 주기 시작, compare = 다음 엣지.
+ *                               정렬된 엣지 테이블을 순회하며 포트 단위로 일괄 clear.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include "pwm.h"
+
+
+#if (MCU_TYPE == MCU_ATMEGA128)
+/* -------------------------------------------------------------------------- */
+/*                               HARDWARE PWM                                 */
+/* -------------------------------------------------------------------------- */
+/* Timer0 : CS02:0 = 1:/1 2:/8 3:/32 4:/64 5:/128 6:/256 7:/1024             */
+/* Timer2/3 : CS 1:/1 2:/8 3:/64 4:/256 5:/1024                              */
+static const uint16_t pwm_div_t0[]  = { 1, 8, 32, 64, 128, 256, 1024 };
+static const uint16_t pwm_div_t23[] = { 1, 8, 64, 256, 1024 };
+
+static bool     pwm_sw_running = false;   // Timer2 를 software PWM 이 사용 중
+static bool     pwm_oc2_used   = false;   // Timer2 를 PWM_HW_OC2 가 사용 중
+static uint16_t pwm_t3_top     = 0;       // Timer3 TOP (ICR3)
+static uint8_t  pwm_t3_duty[3];           // OC3A/B/C duty (0 ~ 255), TOP 변경 시 OCR3x 재계산용
+
+/**
+ * @brief  8bit phase correct: 원하는 주파수에 가장 가까운 prescaler 선택
+ * @return CS 비트 값 (1 ~ n)
+ */
+static uint8_t pwmSelectCs8(const uint16_t *div, uint8_t n, uint32_t freq_hz)
+{
+    uint8_t  best_cs  = 1;
+    uint32_t best_err = 0xFFFFFFFFUL;
+
+    for (uint8_t i = 0; i < n; i++)
+    {
+        uint32_t f   = F_CPU / ((uint32_t)div[i] * 510UL);
+        uint32_t err = (f > freq_hz) ? (f - freq_hz) : (freq_hz - f);
+
+        if (err < best_err)
+        {
+            best_err = err;
+            best_cs  = i + 1;
+        }
+    }
+
+    return best_cs;
+}
+
+/**
+ * @brief  Timer3 channel duty → OCR3x (현재 pwm_t3_top 기준)
+ *         16bit 레지스터 쓰기 (TEMP 공유) → 호출자가 cli 구간에서 호출
+ */
+static void pwmT3Apply(uint8_t idx)
+{
+    uint16_t ocr3 = (uint16_t)(((uint32_t)pwm_t3_duty[idx] * pwm_t3_top) / PWM_DUTY_MAX);
+
+    if (idx == 0) OCR3A = ocr3;
+    if (idx == 1) OCR3B = ocr3;
+    if (idx == 2) OCR3C = ocr3;
+}
+
+/**
+ * @brief  Start hardware PWM channel (phase correct PWM)
+ *         OC3A/B/C 는 주파수 공통 → TOP 이 바뀌면 이미 켜진 채널의 OCR3x 도 저장된 duty 로 재계산.
+ */
+bool pwmHwInit(pwm_hw_ch_t ch, uint32_t freq_hz)
+{
+    if (freq_hz == 0) return false;
+
+    switch (ch)
+    {
+        case PWM_HW_OC0:
+            if (TCCR0 & (1 << WGM01)) return false;     // Timer0 = 1-Wire (CTC)
+            OCR0  = 0;
+            TCCR0 = (1 << WGM00) | (1 << COM01)           // phase correct, non-inverting
+                  | pwmSelectCs8(pwm_div_t0, 7, freq_hz);
+            DDRB |= (1 << 4);                            // OC0 = PB4
+            return true;
+
+        case PWM_HW_OC2:
+            if (pwm_sw_running) return false;           // Timer2 = software PWM
+            pwm_oc2_used = true;
+            OCR2  = 0;
+            TCCR2 = (1 << WGM20) | (1 << COM21)
+                  | pwmSelectCs8(pwm_div_t23, 5, freq_hz);
+            DDRB |= (1 << 7);                            // OC2 = PB7
+            return true;
+
+        case PWM_HW_OC3A:
+        case PWM_HW_OC3B:
+        case PWM_HW_OC3C:
+        {
+            uint8_t  idx = (uint8_t)(ch - PWM_HW_OC3A);
+            uint8_t  cs  = 0;
+            uint32_t top = 0;
+            uint8_t  sreg;
+
+            if (ETIMSK & (1 << TICIE3)) return false;   // Timer3 = input capture
+
+            // 해상도 최대: TOP ≤ 0xFFFF 를 만족하는 가장 작은 prescaler
+            for (uint8_t i = 0; i < 5; i++)
+            {
+                top = F_CPU / (2UL * pwm_div_t23[i] * freq_hz);
+                if (top <= 0xFFFF)
+                {
+                    cs = i + 1;
+                    break;
+                }
+            }
+            if (cs == 0 || top < 2) return false;       // 범위 밖 주파수
+
+            sreg = SREG;
+            cli();
+            pwm_t3_top       = (uint16_t)top;
+            pwm_t3_duty[idx] = 0;
+            ICR3   = pwm_t3_top;
+            TCCR3A = (TCCR3A & ((1 << COM3A1) | (1 << COM3B1) | (1 << COM3C1)))
+                   | (1 << WGM31);                       // mode 10: phase correct, TOP = ICR3
+            TCCR3B = (1 << WGM33) | cs;
+
+            if (ch == PWM_HW_OC3A) { TCCR3A |= (1 << COM3A1); DDRE |= (1 << 3); }
+            if (ch == PWM_HW_OC3B) { TCCR3A |= (1 << COM3B1); DDRE |= (1 << 4); }
+            if (ch == PWM_HW_OC3C) { TCCR3A |= (1 << COM3C1); DDRE |= (1 << 5); }
+
+            // 새 TOP 기준 OCR3x (사용하지 않는 채널은 duty 0 → OCR 0)
+            for (uint8_t i = 0; i < 3; i++)
+                pwmT3Apply(i);
+            SREG = sreg;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief  Set hardware PWM duty (OCR 이중 버퍼 → TOP에서 적용)
+ */
+void pwmHwSetDuty(pwm_hw_ch_t ch, uint8_t duty)
+{
+    uint8_t sreg;
+
+    switch (ch)
+    {
+        case PWM_HW_OC0: OCR0 = duty; break;
+        case PWM_HW_OC2: OCR2 = duty; break;
+        case PWM_HW_OC3A:
+        case PWM_HW_OC3B:
+        case PWM_HW_OC3C:
+            sreg = SREG;
+            cli();                                      // 16bit 레지스터 쓰기 (TEMP 공유)
+            pwm_t3_duty[ch - PWM_HW_OC3A] = duty;
+            pwmT3Apply((uint8_t)(ch - PWM_HW_OC3A));
+            SREG = sreg;
+            break;
+        default:
+            break;
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                               SOFTWARE PWM                                 */
+/* -------------------------------------------------------------------------- */
+/*
+ * 주기(256 tick) 시작 : TIMER2_OVF → 사용 포트마다 1회 쓰기로 duty>0 채널 HIGH
+ * 각 엣지          : TIMER2_COMP → 같은 시각 채널들을 포트별 마스크로 한 번에 LOW
+ *
+ * duty 변경은 비활성 frame 에 정렬 테이블을 다시 만들고 pending 표시,
+ * ISR 이 주기 시작에서 frame 을 교체 → 주기 중간 변경(glitch) 없음.
+ *
+ * OVF 처리 중에 이미 지나간(또는 PWM_SW_MARGIN 이내) 엣지는 OVF 안에서 바로 처리
+ * → 작은 duty 에서 compare 를 놓쳐 한 주기 내내 HIGH (≈100%) 가 되는 일 없음.
+ *   대신 duty tick 이 OVF 처리 시간보다 짧으면 펄스 폭은 OVF 처리 시간으로 늘어남
+ *   (prescaler 8: 1 tick = 8 cycle → 작은 duty 일수록 해당).
+ *
+ * ISR 비용: 미측정 (명령어 수 기준 OVF 약 40 + 포트당 약 12 cycle,
+ *           COMP 약 45 + 엣지당 (12 + 포트당 8) cycle).
+ *           env:bench 의 TIMER2_OVF_vect / TIMER2_COMP_vect 항목으로 확인.
+ *   서로 가까운 엣지(ISR 처리 시간 이내)는 한 번의 ISR 에서 연속 처리된다.
+ */
+/* PWM_SW_MARGIN: 이 tick 이내로 다가온 엣지는 같은 ISR 에서 처리.
+ * 엣지 검사 → OCR2 쓰기 사이 (약 20 cycle) 에 TCNT2 가 엣지를 지나치지 않을 만큼 */
+#if   (PWM_SW_PRESCALER == 8)
+#define PWM_SW_CS       (1 << CS21)
+#define PWM_SW_MARGIN   4       // 32 cycle
+#elif (PWM_SW_PRESCALER == 64)
+#define PWM_SW_CS       ((1 << CS21) | (1 << CS20))
+#define PWM_SW_MARGIN   2
+#elif (PWM_SW_PRESCALER == 256)
+#define PWM_SW_CS       (1 << CS22)
+#define PWM_SW_MARGIN   2
+#elif (PWM_SW_PRESCALER == 1024)
+#define PWM_SW_CS       ((1 << CS22) | (1 << CS20))
+#define PWM_SW_MARGIN   2
+#else
+#error "PWM_SW_PRESCALER must be 8, 64, 256 or 1024"
+#endif
+
+typedef struct
+{
+    uint8_t time;                       // 엣지 시각 (Timer2 count = duty)
+    uint8_t clr[PWM_SW_PORT_MAX];       // 포트별 LOW 로 만들 마스크
+} pwm_sw_edge_t;
+
+typedef struct
+{
+    uint8_t       set[PWM_SW_PORT_MAX]; // 주기 시작 시 HIGH 마스크 (duty > 0)
+    uint8_t       n_edge;               // 유효 엣지 수
+    pwm_sw_edge_t edge[PWM_SW_CH_MAX];  // time 오름차순
+} pwm_sw_frame_t;
+
+typedef struct
+{
+    bool    used;           // attach 여부
+    uint8_t port_idx;       // pwm_sw_port[] 인덱스
+    uint8_t mask;           // 핀 마스크
+    uint8_t duty;           // 현재 duty
+} pwm_sw_ch_t;
+
+static volatile uint8_t *pwm_sw_port[PWM_SW_PORT_MAX];  // 사용 포트 출력 레지스터
+static uint8_t           pwm_sw_own[PWM_SW_PORT_MAX];   // 포트별 PWM 핀 전체 마스크
+static uint8_t           pwm_sw_n_port = 0;             // 사용 포트 수
+
+static pwm_sw_ch_t       pwm_sw_ch[PWM_SW_CH_MAX];      // 논리 채널
+static pwm_sw_frame_t    pwm_sw_frame[2];               // 이중 버퍼 엣지 테이블
+static volatile uint8_t  pwm_sw_act     = 0;            // ISR 이 사용하는 frame
+static volatile bool     pwm_sw_pending = false;        // 비활성 frame 교체 요청
+static uint8_t           pwm_sw_edge_idx = 0;           // 다음 처리할 엣지 (ISR 전용)
+
+/**
+ * @brief  Rebuild sorted edge table into inactive frame and request swap
+ */
+static void pwmSwBuild(void)
+{
+    pwm_sw_frame_t *f;
+    uint8_t sreg;
+
+    // pending 해제 후에는 ISR 이 교체하지 않으므로 비활성 frame 을 안전하게 수정 가능
+    sreg = SREG;
+    cli();
+    pwm_sw_pending = false;
+    SREG = sreg;
+
+    f = &pwm_sw_frame[pwm_sw_act ^ 1];
+    memset(f, 0, sizeof(pwm_sw_frame_t));
+
+    for (uint8_t i = 0; i < PWM_SW_CH_MAX; i++)
+    {
+        pwm_sw_ch_t *c = &pwm_sw_ch[i];
+        uint8_t k;
+
+        if (!c->used || c->duty == 0) continue;
+
+        f->set[c->port_idx] |= c->mask;
+        if (c->duty == PWM_DUTY_MAX) continue;          // 100% → clear 엣지 없음
+
+        // 삽입 정렬 (같은 시각이면 마스크 병합)
+        for (k = 0; k < f->n_edge && f->edge[k].time < c->duty; k++);
+
+        if (k < f->n_edge && f->edge[k].time == c->duty)
+        {
+            f->edge[k].clr[c->port_idx] |= c->mask;
+            continue;
+        }
+
+        memmove(&f->edge[k + 1], &f->edge[k], (f->n_edge - k) * sizeof(pwm_sw_edge_t));
+        memset(&f->edge[k], 0, sizeof(pwm_sw_edge_t));
+        f->edge[k].time = c->duty;
+        f->edge[k].clr[c->port_idx] = c->mask;
+        f->n_edge++;
+    }
+
+    pwm_sw_pending = true;
+}
+
+/**
+ * @brief  Start software PWM engine on Timer2
+ */
+bool pwmSwInit(void)
+{
+    if (pwm_oc2_used) return false;
+
+    cli();
+    pwm_sw_running = true;
+    TCCR2  = 0x00;                  // normal mode, OC2 disconnected
+    TCNT2  = 0;
+    TIFR   = (1 << TOV2) | (1 << OCF2);
+    TIMSK |= (1 << TOIE2);
+    TCCR2  = PWM_SW_CS;
+    sei();
+
+    return true;
+}
+
+/**
+ * @brief  Release channel pin (cli 구간에서 호출)
+ *         두 frame 에서 핀 마스크를 지워 ISR 이 이전 핀을 더 이상 구동하지 않게 하고,
+ *         포트에 남은 PWM 핀이 없으면 마지막 포트 슬롯을 빈 자리로 옮겨 슬롯을 반납한다.
+ */
+static void pwmSwRelease(uint8_t ch)
+{
+    pwm_sw_ch_t *c = &pwm_sw_ch[ch];
+    uint8_t k = c->port_idx;
+    uint8_t last;
+
+    pwm_sw_own[k]   &= ~c->mask;
+    *pwm_sw_port[k] &= ~c->mask;                        // 이전 핀은 LOW 로 정지
+    for (uint8_t b = 0; b < 2; b++)
+    {
+        pwm_sw_frame[b].set[k] &= ~c->mask;
+        for (uint8_t e = 0; e < PWM_SW_CH_MAX; e++)
+            pwm_sw_frame[b].edge[e].clr[k] &= ~c->mask;
+    }
+    c->used = false;
+
+    if (pwm_sw_own[k] != 0) return;                     // 같은 포트에 다른 채널이 남음
+
+    last = pwm_sw_n_port - 1;
+    if (k != last)
+    {
+        pwm_sw_port[k]    = pwm_sw_port[last];
+        pwm_sw_own[k]     = pwm_sw_own[last];
+        pwm_sw_own[last]  = 0;
+        for (uint8_t b = 0; b < 2; b++)
+        {
+            pwm_sw_frame[b].set[k]    = pwm_sw_frame[b].set[last];
+            pwm_sw_frame[b].set[last] = 0;
+            for (uint8_t e = 0; e < PWM_SW_CH_MAX; e++)
+            {
+                pwm_sw_frame[b].edge[e].clr[k]    = pwm_sw_frame[b].edge[e].clr[last];
+                pwm_sw_frame[b].edge[e].clr[last] = 0;
+            }
+        }
+        for (uint8_t i = 0; i < PWM_SW_CH_MAX; i++)
+        {
+            if (pwm_sw_ch[i].used && pwm_sw_ch[i].port_idx == last)
+                pwm_sw_ch[i].port_idx = k;
+        }
+    }
+    pwm_sw_n_port = last;
+}
+
+/**
+ * @brief  Bind software PWM channel to logical GPIO
+ *         이미 attach 된 채널은 이전 핀을 해제 후 새 핀에 연결 (duty 0 으로 시작).
+ * @return false = 잘못된 인자 또는 포트 슬롯 부족 (이전 핀은 해제된 상태)
+ */
+bool pwmSwAttach(uint8_t ch, gpio_id_t id)
+{
+    gpio_reg_t reg;
+    uint8_t k;
+    uint8_t sreg;
+
+    if (ch >= PWM_SW_CH_MAX || !gpioGetReg(id, &reg)) return false;
+
+    sreg = SREG;
+    cli();
+    if (pwm_sw_ch[ch].used)
+        pwmSwRelease(ch);
+
+    for (k = 0; k < pwm_sw_n_port && pwm_sw_port[k] != reg.out; k++);
+    if (k == PWM_SW_PORT_MAX)                           // 사용 가능한 포트 슬롯 없음
+    {
+        SREG = sreg;
+        pwmSwBuild();
+        return false;
+    }
+
+    if (k == pwm_sw_n_port)
+    {
+        pwm_sw_port[k] = reg.out;
+        pwm_sw_n_port++;
+    }
+    pwm_sw_own[k]      |= reg.mask;
+    *reg.out           &= ~reg.mask;                    // LOW 로 시작
+    *reg.ddr           |= reg.mask;                     // output
+    pwm_sw_ch[ch].used     = true;
+    pwm_sw_ch[ch].port_idx = k;
+    pwm_sw_ch[ch].mask     = reg.mask;
+    pwm_sw_ch[ch].duty     = 0;
+    SREG = sreg;
+
+    pwmSwBuild();
+    return true;
+}
+
+/**
+ * @brief  Set software PWM duty (다음 주기 시작에서 적용)
+ */
+void pwmSwSetDuty(uint8_t ch, uint8_t duty)
+{
+    if (ch >= PWM_SW_CH_MAX || !pwm_sw_ch[ch].used) return;
+    if (pwm_sw_ch[ch].duty == duty) return;
+
+    pwm_sw_ch[ch].duty = duty;
+    pwmSwBuild();
+}
+
+/* -------------------------------------------------------------------------- */
+/*                            SOFTWARE PWM ISR                                */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  idx 부터 현재 시각(+PWM_SW_MARGIN)까지 도달한 엣지를 모두 처리
+ * @return 다음 처리할 엣지 인덱스
+ */
+static inline __attribute__((always_inline)) uint8_t pwmSwCatchUp(const pwm_sw_frame_t *f, uint8_t idx)
+{
+    while (idx < f->n_edge &&
+           (uint16_t)f->edge[idx].time <= ((uint16_t)TCNT2 + PWM_SW_MARGIN))
+    {
+        const pwm_sw_edge_t *e = &f->edge[idx];
+
+        for (uint8_t k = 0; k < pwm_sw_n_port; k++)
+            *pwm_sw_port[k] &= ~e->clr[k];
+        idx++;
+    }
+
+    return idx;
+}
+
+/**
+ * @brief  Period start: frame 교체, 사용 포트 일괄 갱신,
+ *         이미 도달한 엣지 처리 후 다음 엣지 예약
+ */
+ISR(TIMER2_OVF_vect)
+{
+    const pwm_sw_frame_t *f;
+    uint8_t idx;
+
+    if (pwm_sw_pending)
+    {
+        pwm_sw_act    ^= 1;
+        pwm_sw_pending = false;
+    }
+    f = &pwm_sw_frame[pwm_sw_act];
+
+    for (uint8_t k = 0; k < pwm_sw_n_port; k++)
+        *pwm_sw_port[k] = (*pwm_sw_port[k] & ~pwm_sw_own[k]) | f->set[k];
+
+    idx = pwmSwCatchUp(f, 0);           // OVF 지연 중 지나간 작은 duty 엣지
+
+    pwm_sw_edge_idx = idx;
+    if (idx < f->n_edge)
+    {
+        OCR2   = f->edge[idx].time;
+        TIFR   = (1 << OCF2);           // 이전 주기 잔여 플래그 제거
+        TIMSK |= (1 << OCIE2);
+    }
+    else
+    {
+        TIMSK &= ~(1 << OCIE2);
+    }
+}
+
+/**
+ * @brief  Edge: 현재 시각까지 도달한 엣지를 모두 처리 후 다음 엣지 예약
+ */
+ISR(TIMER2_COMP_vect)
+{
+    const pwm_sw_frame_t *f = &pwm_sw_frame[pwm_sw_act];
+    const pwm_sw_edge_t  *e = &f->edge[pwm_sw_edge_idx];
+    uint8_t idx;
+
+    for (uint8_t k = 0; k < pwm_sw_n_port; k++)     // compare 가 발생한 엣지
+        *pwm_sw_port[k] &= ~e->clr[k];
+
+    idx = pwmSwCatchUp(f, pwm_sw_edge_idx + 1);
+
+    pwm_sw_edge_idx = idx;
+    if (idx < f->n_edge)
+        OCR2 = f->edge[idx].time;
+    else
+        TIMSK &= ~(1 << OCIE2);         // 이번 주기 엣지 종료
+}
+
+#endif /* MCU_ATMEGA128 */
@@ -2,56 +2,537 @@
  * File: uart.c
  * Author: Young Kwan CHO, Lilith
  * Description: ATmega128 UART HAL Wrapper
- *              Provides simple TX-only UART for debugging/logging.
+ *              Instance-based driver for USART0 / USART1.
+ *              채널별 baud, RX/TX 링버퍼, ISR을 독립적으로 가진다.
+ *              uartInit/uartWrite/uartPrint 는 USART0 wrapper.
+ *              MCU_HOST: stdout / fd / pty 로 입출력.
  */
 
 /* -------------------------------------------------------------------------- */
 /*                                INCLUDE FILES                               */
 /* -------------------------------------------------------------------------- */
 #include "uart.h"
+#include "trace.h"   // TRACE_ENTER/EXIT (_USE_TRACE)
+
+
+#if (MCU_TYPE == MCU_ATMEGA128) || (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                               BAUD ENGINE                                  */
+/* -------------------------------------------------------------------------- */
+/*
+ * baud = F_CPU / (div * (UBRR + 1)),  div = 16 (normal) / 8 (U2X)
+ * 두 모드 각각 반올림된 divisor로 실제 baud와 오차를 계산하여
+ * 오차가 작은 쪽을 선택 (동률이면 수신 노이즈 내성이 좋은 normal 선택).
+ *
+ * 16MHz 예) 38400 : normal UBRR=25  +0.16%
+ *           57600 : U2X    UBRR=34  -0.79%
+ *          115200 : U2X    UBRR=16  +2.12%  (허용치 초과 → false)
+ *          250k/500k/1M : normal UBRR=3/1/0  0.00%
+ *           2M    : U2X    UBRR=0   0.00%
+ */
+#define UART_UBRR_MAX       4095        // UBRR 12bit
+
+typedef struct
+{
+    uint16_t ubrr;          // UBRRn 설정값
+    bool     u2x;           // double speed 사용 여부
+    uint32_t actual;        // 실제 baud
+    int16_t  err;           // 오차 [0.01%]
+} uart_baud_t;
+
+static uart_baud_t uartCalcBaud(uint32_t baud, bool u2x)
+{
+    uart_baud_t r;
+    uint32_t div = (u2x ? 8UL : 16UL) * baud;
+    uint32_t n   = (F_CPU + (div / 2)) / div;          // 반올림 divisor = UBRR + 1
+    int32_t  diff;
+    uint32_t mag;
+
+    if (n < 1)                    n = 1;
+    if (n > (UART_UBRR_MAX + 1))  n = UART_UBRR_MAX + 1;
+
+    r.ubrr   = (uint16_t)(n - 1);
+    r.u2x    = u2x;
+    r.actual = (F_CPU + ((u2x ? 8UL : 16UL) * n / 2)) / ((u2x ? 8UL : 16UL) * n);
+
+    diff = (int32_t)r.actual - (int32_t)baud;
+    mag  = (diff < 0) ? (uint32_t)(-diff) : (uint32_t)diff;
+    if (mag > (baud / 8))
+    {
+        r.err = (diff > 0) ? INT16_MAX : INT16_MIN;    // 설정 불가 수준 (±12.5% 초과)
+        return r;
+    }
+
+    // mag * 10000 은 mag > 429496 (baud ≥ 약 3.4M) 에서 32bit 초과
+    // → 그 범위에서만 baud 를 먼저 100 으로 나눔 (절삭 오차 < 0.003%)
+    if (mag <= (UINT32_MAX / 10000UL))
+        mag = (mag * 10000UL) / baud;
+    else
+        mag = (mag * 100UL) / (baud / 100UL);
+
+    r.err = (diff < 0) ? -(int16_t)mag : (int16_t)mag;    // mag ≤ 1250
+
+    return r;
+}
+
+static uint16_t uartAbsErr(int16_t err)
+{
+    return (err < 0) ? (uint16_t)(-(int32_t)err) : (uint16_t)err;
+}
+
+/**
+ * @brief  Select best UBRR/U2X for baud
+ * @param  p_baud 선택 결과 저장
+ * @return true = 오차가 UART_BAUD_ERR_MAX 이내
+ */
+static bool uartSelectBaud(uint32_t baud, uart_baud_t *p_baud)
+{
+    uart_baud_t normal, dbl;
+
+    if (baud == 0)
+    {
+        memset(p_baud, 0, sizeof(uart_baud_t));
+        p_baud->err = INT16_MIN;
+        return false;
+    }
+
+    normal = uartCalcBaud(baud, false);
+    dbl    = uartCalcBaud(baud, true);
+
+    *p_baud = (uartAbsErr(dbl.err) < uartAbsErr(normal.err)) ? dbl : normal;
+
+    return (uartAbsErr(p_baud->err) <= UART_BAUD_ERR_MAX);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                              CHANNEL CONTEXT                               */
+/* -------------------------------------------------------------------------- */
+#define UART_RX_MASK    (UART_RX_BUF_SIZE - 1)
+#define UART_TX_MASK    (UART_TX_BUF_SIZE - 1)
+
+#if (UART_RX_BUF_SIZE & UART_RX_MASK) || (UART_RX_BUF_SIZE > 256) || \
+    (UART_TX_BUF_SIZE & UART_TX_MASK) || (UART_TX_BUF_SIZE > 256)
+#error "UART_RX/TX_BUF_SIZE must be a power of 2 and <= 256"
+#endif
+
+typedef struct
+{
+    bool             is_open;                     // 채널 열림 상태
+    uart_baud_t      baud;                        // 적용된 baud 설정
+    uint8_t          rx_buf[UART_RX_BUF_SIZE];    // 수신 링버퍼
+    volatile uint8_t rx_head;                     // ISR 기록 위치
+    volatile uint8_t rx_tail;                     // 읽기 위치
+    volatile uint16_t rx_ovf;                     // 버퍼 가득 참으로 버린 바이트 수
+    uint8_t          tx_buf[UART_TX_BUF_SIZE];    // 송신 링버퍼
+    volatile uint8_t tx_head;                     // 쓰기 위치
+    volatile uint8_t tx_tail;                     // ISR 송신 위치
+    volatile bool    tx_last;                     // 마지막 byte 를 UDR 에 넣고 TXC 를 해제함 (uartFlush 대기 대상)
+} uart_ctx_t;
+
+static uart_ctx_t uart_ctx[UART_MAX_CH];         // 채널별 상태
+
+/* ISR/host 공통: 수신 바이트 1개를 링버퍼에 저장 */
+static inline void uartRxPush(uart_ctx_t *p, uint8_t data)
+{
+    uint8_t next = (p->rx_head + 1) & UART_RX_MASK;
+
+    if (next == p->rx_tail)
+    {
+        p->rx_ovf++;            // 가득 참 → 버림
+        return;
+    }
+
+    p->rx_buf[p->rx_head] = data;
+    p->rx_head = next;
+}
+
+#endif /* MCU_ATMEGA128 || MCU_HOST */
 
 
 #if (MCU_TYPE == MCU_ATMEGA128)
 /* -------------------------------------------------------------------------- */
-/*                               UART INIT                                    */
+/*                             USART DESCRIPTORS                              */
+/* -------------------------------------------------------------------------- */
+/* USART0/1 레지스터 묶음. const + 상수 인덱스 → ISR에서 주소가 상수로 접힘  */
+/* (USART0/1 의 비트 위치는 동일하므로 *0 비트명을 공용으로 사용)            */
+typedef struct
+{
+    volatile uint8_t *udr;      // UDRn
+    volatile uint8_t *ucsra;    // UCSRnA
+    volatile uint8_t *ucsrb;    // UCSRnB
+    volatile uint8_t *ucsrc;    // UCSRnC
+    volatile uint8_t *ubrrh;    // UBRRnH
+    volatile uint8_t *ubrrl;    // UBRRnL
+} uart_hw_t;
+
+static const uart_hw_t uart_hw[UART_MAX_CH] =
+{
+    { &UDR0, &UCSR0A, &UCSR0B, &UCSR0C, &UBRR0H, &UBRR0L },   // UART_CH0 : PE0/PE1
+    { &UDR1, &UCSR1A, &UCSR1B, &UCSR1C, &UBRR1H, &UBRR1L },   // UART_CH1 : PD2/PD3
+};
+
+/* -------------------------------------------------------------------------- */
+/*                              ISR HANDLERS                                  */
 /* -------------------------------------------------------------------------- */
 /**
- * @brief Initialize UART0
- *        Only TX is enabled (RX not required for debugging)
+ * @brief  링버퍼 → UDR 1 byte (UDRE ISR / 인터럽트 금지 상태의 직접 송신 공용)
+ *         링버퍼가 비면 TXC 를 해제 → uartFlush() 가 TXC(shift register 비움)로 완료 판단.
+ *         UCSRnA 쓰기: TXC 는 1 쓰기로 해제, U2X/MPCM 은 유지.
  */
-void uartInit(uint32_t baud)
+static inline __attribute__((always_inline)) void uartTxLoad(const uart_hw_t *hw, uart_ctx_t *p, uint8_t tail)
+{
+    *hw->udr   = p->tx_buf[tail];
+    tail       = (tail + 1) & UART_TX_MASK;
+    p->tx_tail = tail;
+
+    if (tail == p->tx_head)
+    {
+        *hw->ucsra = (*hw->ucsra & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0);
+        p->tx_last = true;
+    }
+}
+
+/* always_inline: 벡터별로 상수 채널이 전달되어 하드코딩 드라이버와 동일 코드 */
+static inline __attribute__((always_inline)) void uartIsrRx(uart_ch_t ch)
+{
+    const uart_hw_t *hw = &uart_hw[ch];
+    uint8_t status = *hw->ucsra;
+    uint8_t data   = *hw->udr;          // UDR 읽기로 RXC 해제
+
+    if (status & ((1 << FE0) | (1 << UPE0)))
+        return;                         // frame/parity 오류 바이트는 버림
+
+    uartRxPush(&uart_ctx[ch], data);
+}
+
+static inline __attribute__((always_inline)) void uartIsrUdre(uart_ch_t ch)
 {
-    uint16_t ubrr = (F_CPU / (16UL * baud)) - 1;
+    const uart_hw_t *hw = &uart_hw[ch];
+    uart_ctx_t *p = &uart_ctx[ch];
+    uint8_t tail = p->tx_tail;
 
-    UBRR0H = (ubrr >> 8);
-    UBRR0L = (ubrr & 0xFF);
+    if (tail == p->tx_head)
+    {
+        *hw->ucsrb &= ~(1 << UDRIE0);   // 보낼 데이터 없음 → UDRE 인터럽트 정지
+        return;
+    }
 
-    UCSR0B = (1 << TXEN0);                    // Enable TX only
-    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);   // 8N1 mode
+    uartTxLoad(hw, p, tail);
+}
+
+ISR(USART0_RX_vect)   { uartIsrRx(UART_CH0);   }
+ISR(USART0_UDRE_vect) { uartIsrUdre(UART_CH0); }
+ISR(USART1_RX_vect)   { uartIsrRx(UART_CH1);   }
+ISR(USART1_UDRE_vect) { uartIsrUdre(UART_CH1); }
+
+/* -------------------------------------------------------------------------- */
+/*                               UART OPEN                                    */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Open channel: baud 설정, 8N1, RX/TX 및 RX 인터럽트 활성화
+ *         오차 허용치 초과 시에도 가장 가까운 설정은 적용하고 false 반환.
+ */
+bool uartOpen(uart_ch_t ch, uint32_t baud)
+{
+    const uart_hw_t *hw;
+    uart_ctx_t *p;
+    uint8_t sreg;
+    bool ok;
+
+    if (ch >= UART_MAX_CH) return false;
+
+    hw = &uart_hw[ch];
+    p  = &uart_ctx[ch];
+    ok = uartSelectBaud(baud, &p->baud);
+
+    sreg = SREG;
+    cli();
+
+    *hw->ucsrb = 0x00;                                  // 설정 중 송수신 정지
+    p->rx_head = p->rx_tail = 0;
+    p->tx_head = p->tx_tail = 0;
+    p->tx_last = false;
+    p->rx_ovf  = 0;
+
+    *hw->ucsra = p->baud.u2x ? (1 << U2X0) : 0;
+    *hw->ubrrh = (p->baud.ubrr >> 8);
+    *hw->ubrrl = (p->baud.ubrr & 0xFF);
+    *hw->ucsrc = (1 << UCSZ01) | (1 << UCSZ00);         // 8N1 mode
+    *hw->ucsrb = (1 << RXEN0) | (1 << TXEN0) | (1 << RXCIE0);
+
+    p->is_open = true;
+    SREG = sreg;
+
+    return ok;
 }
 
 /* -------------------------------------------------------------------------- */
 /*                               UART WRITE                                   */
 /* -------------------------------------------------------------------------- */
 /**
- * @brief Send one byte
+ * @brief  Queue one byte (interrupt-driven TX)
+ *         버퍼가 가득 차면 빈 자리가 생길 때까지 대기.
+ *         인터럽트 금지 상태에서 가득 찬 경우 직접 UDR로 밀어내 교착을 피한다.
  */
-void uartWrite(char c)
+void uartWriteCh(uart_ch_t ch, char c)
+{
+    const uart_hw_t *hw;
+    uart_ctx_t *p;
+    uint8_t next;
+    uint8_t sreg;
+
+    if (ch >= UART_MAX_CH || !uart_ctx[ch].is_open) return;
+
+    hw   = &uart_hw[ch];
+    p    = &uart_ctx[ch];
+    next = (p->tx_head + 1) & UART_TX_MASK;
+
+    while (next == p->tx_tail)
+    {
+        if (!(SREG & (1 << SREG_I)) && (*hw->ucsra & (1 << UDRE0)))
+            uartTxLoad(hw, p, p->tx_tail);              // ISR 대신 직접 송신
+    }
+
+    p->tx_buf[p->tx_head] = (uint8_t)c;
+
+    sreg = SREG;
+    cli();
+    p->tx_head  = next;
+    *hw->ucsrb |= (1 << UDRIE0);                        // UCSR1B는 RMW 비원자 → cli 구간
+    SREG = sreg;
+}
+
+/**
+ * @brief  Wait until every queued byte has left the shift register
+ */
+void uartFlush(uart_ch_t ch)
+{
+    const uart_hw_t *hw;
+    uart_ctx_t *p;
+
+    if (ch >= UART_MAX_CH || !uart_ctx[ch].is_open) return;
+
+    hw = &uart_hw[ch];
+    p  = &uart_ctx[ch];
+
+    while (p->tx_head != p->tx_tail)
+    {
+        if (!(SREG & (1 << SREG_I)) && (*hw->ucsra & (1 << UDRE0)))
+            uartTxLoad(hw, p, p->tx_tail);
+    }
+
+    // 마지막 byte 적재 시 TXC 해제 → TXC = shift register 까지 비움 (frame 형식/부하와 무관)
+    // 한 번도 송신하지 않은 채널은 TXC 가 켜지지 않으므로 대기하지 않음
+    if (p->tx_last)
+    {
+        while (!(*hw->ucsra & (1 << TXC0)));
+        p->tx_last = false;
+    }
+}
+
+#elif (MCU_TYPE == MCU_HOST)
+/* -------------------------------------------------------------------------- */
+/*                                HOST BACKEND                                */
+/* -------------------------------------------------------------------------- */
+#include <unistd.h>
+#include <fcntl.h>
+
+static int host_fd[UART_MAX_CH]    = { STDOUT_FILENO, -1 };  // 출력 대상 (-1 = 버림)
+static int host_rx_fd[UART_MAX_CH] = { -1, -1 };             // 수신 원본 (pty)
+
+bool uartOpen(uart_ch_t ch, uint32_t baud)
+{
+    uart_ctx_t *p;
+
+    if (ch >= UART_MAX_CH) return false;
+
+    p = &uart_ctx[ch];
+    p->rx_head = p->rx_tail = 0;
+    p->tx_head = p->tx_tail = 0;
+    p->tx_last = false;
+    p->rx_ovf  = 0;
+    p->is_open = true;
+
+    return uartSelectBaud(baud, &p->baud);  // 실제 하드웨어 설정값/오차만 계산
+}
+
+void uartWriteCh(uart_ch_t ch, char c)
+{
+    if (ch >= UART_MAX_CH || !uart_ctx[ch].is_open || host_fd[ch] < 0) return;
+
+    if (write(host_fd[ch], &c, 1) < 0)
+    {
+        // 출력 실패는 무시 (테스트 종료 후 파이프 닫힘 등)
+    }
+}
+
+void uartFlush(uart_ch_t ch)
+{
+    (void)ch;                           // write()는 즉시 출력
+}
+
+/* pty 에 도착한 바이트를 RX 링버퍼로 이동 (uartAvailable()에서 호출) */
+static void uartHostPoll(uart_ch_t ch)
+{
+    uint8_t buf[UART_RX_BUF_SIZE];
+    ssize_t n;
+
+    if (host_rx_fd[ch] < 0) return;
+
+    n = read(host_rx_fd[ch], buf, sizeof(buf));
+    for (ssize_t i = 0; i < n; i++)
+        uartRxPush(&uart_ctx[ch], buf[i]);
+}
+
+void uartHostSetFd(uart_ch_t ch, int fd)
+{
+    if (ch < UART_MAX_CH)
+        host_fd[ch] = fd;
+}
+
+void uartHostInject(uart_ch_t ch, const uint8_t *data, uint32_t len)
+{
+    if (ch >= UART_MAX_CH) return;
+
+    while (len--)
+        uartRxPush(&uart_ctx[ch], *data++);
+}
+
+bool uartHostOpenPty(uart_ch_t ch, char *name, size_t len)
 {
-    while (!(UCSR0A & (1 << UDRE0)));   // Wait until TX buffer empty
-    UDR0 = c;
+    int fd;
+
+    if (ch >= UART_MAX_CH) return false;
+
+    fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0) return false;
+    if (grantpt(fd) < 0 || unlockpt(fd) < 0 || ptsname_r(fd, name, len) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    host_fd[ch]    = fd;
+    host_rx_fd[ch] = fd;
+    return true;
 }
 
+#endif /* MCU_TYPE */
+
+
+#if (MCU_TYPE == MCU_ATMEGA128) || (MCU_TYPE == MCU_HOST)
 /* -------------------------------------------------------------------------- */
-/*                            UART PRINT STRING                               */
+/*                             CHANNEL COMMON API                             */
 /* -------------------------------------------------------------------------- */
 /**
- * @brief Send null-terminated string
+ * @brief  Queue buffer
  */
-void uartPrint(const char *str)
+void uartWriteBuf(uart_ch_t ch, const uint8_t *buf, uint32_t len)
 {
+    while (len--)
+        uartWriteCh(ch, (char)*buf++);
+}
+
+/**
+ * @brief  Send null-terminated string
+ */
+void uartPrintCh(uart_ch_t ch, const char *str)
+{
+    TRACE_ENTER(TRACE_EVT_UART_TX);
     while (*str)
-        uartWrite(*str++);
+        uartWriteCh(ch, *str++);
+    TRACE_EXIT(TRACE_EVT_UART_TX);
+}
+
+/**
+ * @brief  Number of received bytes waiting
+ */
+uint32_t uartAvailable(uart_ch_t ch)
+{
+    uart_ctx_t *p;
+
+    if (ch >= UART_MAX_CH) return 0;
+
+#if (MCU_TYPE == MCU_HOST)
+    uartHostPoll(ch);
+#endif
+    p = &uart_ctx[ch];
+    return (uint8_t)(p->rx_head - p->rx_tail) & UART_RX_MASK;
+}
+
+/**
+ * @brief  Read one received byte (uartAvailable() 확인 후 호출)
+ * @return 수신 바이트, 비어 있으면 0
+ */
+uint8_t uartRead(uart_ch_t ch)
+{
+    uart_ctx_t *p;
+    uint8_t data;
+
+    if (ch >= UART_MAX_CH) return 0;
+
+    p = &uart_ctx[ch];
+    if (p->rx_head == p->rx_tail) return 0;
+
+    data = p->rx_buf[p->rx_tail];
+    p->rx_tail = (p->rx_tail + 1) & UART_RX_MASK;
+
+    return data;
+}
+
+/**
+ * @brief  Bytes dropped because RX buffer was full
+ */
+uint16_t uartGetRxOverflow(uart_ch_t ch)
+{
+    return (ch < UART_MAX_CH) ? uart_ctx[ch].rx_ovf : 0;
+}
+
+/**
+ * @brief  Actual baudrate of channel
+ */
+uint32_t uartGetBaudCh(uart_ch_t ch)
+{
+    return (ch < UART_MAX_CH) ? uart_ctx[ch].baud.actual : 0;
+}
+
+/**
+ * @brief  Baudrate error of channel [0.01%]
+ */
+int16_t uartGetBaudErrCh(uart_ch_t ch)
+{
+    return (ch < UART_MAX_CH) ? uart_ctx[ch].baud.err : INT16_MIN;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                         USART0 WRAPPER (LEGACY API)                        */
+/* -------------------------------------------------------------------------- */
+bool uartInit(uint32_t baud)
+{
+    return uartOpen(UART_CH0, baud);
+}
+
+void uartWrite(char c)
+{
+    uartWriteCh(UART_CH0, c);
+}
+
+void uartPrint(const char *str)
+{
+    uartPrintCh(UART_CH0, str);
+}
+
+uint32_t uartGetBaud(void)
+{
+    return uartGetBaudCh(UART_CH0);
+}
+
+int16_t uartGetBaudErr(void)
+{
+    return uartGetBaudErrCh(UART_CH0);
 }
 
-#endif /* MCU_ATMEGA128 */
+#endif /* MCU_ATMEGA128 || MCU_HOST */
@@ -16,6 +16,7 @@
 /* -------------------------------------------------------------------------- */
 /*                                 MAIN                                       */
 /* -------------------------------------------------------------------------- */
+#ifndef PIO_UNIT_TESTING       // 단위 테스트 빌드 시 Unity가 main() 제공
 int main(void)
 {
     appInit();      // 시스템 / HAL 초기화
@@ -28,3 +29,4 @@ int main(void)
 
     return 0;       // 도달하지 않음
 }
+#endif
@@ -0,0 +1,219 @@
+/*
+ * File: fixed.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: Fixed-point DSP / control routines
+ *              모든 곱셈은 16 × 16 → 32bit, 누적은 int32 (64bit 연산 없음).
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "fixed.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 ARITHMETIC                                  */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Q7.8 division (0 에 가까운 쪽이 아닌 반올림)
+ */
+q7_8_t q78Div(q7_8_t a, q7_8_t b)
+{
+    int32_t n = (int32_t)a << 8;
+    int32_t half;
+
+    if (b == 0) return (a >= 0) ? INT16_MAX : INT16_MIN;
+
+    half = ((b < 0) ? -(int32_t)b : b) / 2;
+    n   += (n < 0) ? -half : half;
+
+    return fixSat16(n / b);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                               MOVING AVERAGE                                */
+/* -------------------------------------------------------------------------- */
+void fixMaInit(fix_ma_t *p_ma, int16_t *buf, uint8_t shift, int16_t init)
+{
+    if (p_ma == NULL || buf == NULL) return;
+    if (shift > 7) shift = 7;
+
+    p_ma->buf   = buf;
+    p_ma->shift = shift;
+    p_ma->idx   = 0;
+    p_ma->sum   = (int32_t)init << shift;
+
+    for (uint8_t i = 0; i < (uint8_t)(1 << shift); i++)
+        buf[i] = init;
+}
+
+/**
+ * @brief  Add sample, return window mean (합은 정확, 나눗셈 대신 shift)
+ */
+int16_t fixMaUpdate(fix_ma_t *p_ma, int16_t x)
+{
+    uint8_t shift = p_ma->shift;
+
+    p_ma->sum += (int32_t)x - p_ma->buf[p_ma->idx];
+    p_ma->buf[p_ma->idx] = x;
+    p_ma->idx = (p_ma->idx + 1) & ((1 << shift) - 1);
+
+    if (shift == 0) return x;
+
+    return (int16_t)((p_ma->sum + (1L << (shift - 1))) >> shift);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                              FIRST-ORDER IIR                                */
+/* -------------------------------------------------------------------------- */
+void fixIirInit(fix_iir_t *p_iir, q15_t alpha, int16_t init)
+{
+    if (p_iir == NULL) return;
+
+    p_iir->alpha = (alpha < 0) ? 0 : alpha;
+    p_iir->y     = init;
+    p_iir->frac  = 0;
+}
+
+/**
+ * @brief  y += alpha × (x - y)
+ *         |x - y| ≤ 65535, alpha ≤ 32767 → 곱 + 잔차 < 2^31 (overflow 없음).
+ *         잘린 소수부를 frac 에 남겨 다음 샘플에 더함 → 작은 차이도 결국 반영.
+ */
+int16_t fixIirUpdate(fix_iir_t *p_iir, int16_t x)
+{
+    int32_t acc = ((int32_t)x - p_iir->y) * p_iir->alpha + p_iir->frac;
+
+    p_iir->y   += (int16_t)(acc >> 15);
+    p_iir->frac = (int16_t)(acc & 0x7FFF);
+
+    return p_iir->y;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   BIQUAD                                    */
+/* -------------------------------------------------------------------------- */
+void fixBiquadInit(fix_biquad_t *p_bq, q14_t b0, q14_t b1, q14_t b2, q14_t a1, q14_t a2)
+{
+    if (p_bq == NULL) return;
+
+    memset(p_bq, 0, sizeof(fix_biquad_t));
+    p_bq->b0 = b0;
+    p_bq->b1 = b1;
+    p_bq->b2 = b2;
+    p_bq->a1 = a1;
+    p_bq->a2 = a2;
+}
+
+int16_t fixBiquadUpdate(fix_biquad_t *p_bq, int16_t x)
+{
+    int32_t acc = p_bq->err;
+    int16_t y;
+
+    acc += (int32_t)p_bq->b0 * x;
+    acc += (int32_t)p_bq->b1 * p_bq->x1;
+    acc += (int32_t)p_bq->b2 * p_bq->x2;
+    acc -= (int32_t)p_bq->a1 * p_bq->y1;
+    acc -= (int32_t)p_bq->a2 * p_bq->y2;
+
+    y           = fixSat16(acc >> 14);
+    p_bq->err   = (int16_t)(acc & 0x3FFF);    // 잘린 하위 14bit → 다음 샘플
+
+    p_bq->x2 = p_bq->x1;
+    p_bq->x1 = x;
+    p_bq->y2 = p_bq->y1;
+    p_bq->y1 = y;
+
+    return y;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                    PID                                      */
+/* -------------------------------------------------------------------------- */
+void fixPidInit(fix_pid_t *p_pid, q7_8_t kp, q7_8_t ki, q7_8_t kd, int16_t out_min, int16_t out_max)
+{
+    if (p_pid == NULL) return;
+
+    p_pid->kp      = kp;
+    p_pid->ki      = ki;
+    p_pid->kd      = kd;
+    p_pid->out_min = out_min;
+    p_pid->out_max = out_max;
+
+    fixPidReset(p_pid);
+}
+
+void fixPidReset(fix_pid_t *p_pid)
+{
+    if (p_pid == NULL) return;
+
+    p_pid->integ   = 0;
+    p_pid->prev_pv = 0;
+    p_pid->first   = true;
+}
+
+/**
+ * @brief  u = kp·e + Σ ki·e - kd·Δpv   (Q8 누적 후 반올림)
+ *         anti-windup: 적분 상태를 출력 범위로 제한 + 출력이 포화된 방향으로는 적분 중단.
+ */
+int16_t fixPidUpdate(fix_pid_t *p_pid, int16_t sp, int16_t pv)
+{
+    int16_t e   = fixSat16((int32_t)sp - pv);
+    int16_t dpv = p_pid->first ? 0 : fixSat16((int32_t)pv - p_pid->prev_pv);
+    int32_t lo  = (int32_t)p_pid->out_min << 8;
+    int32_t hi  = (int32_t)p_pid->out_max << 8;
+    int32_t pd  = fixSatAdd32((int32_t)p_pid->kp * e, -((int32_t)p_pid->kd * dpv));
+    int32_t integ = p_pid->integ + (int32_t)p_pid->ki * e;
+    int32_t u;
+
+    p_pid->prev_pv = pv;
+    p_pid->first   = false;
+
+    if (integ > hi) integ = hi;
+    else if (integ < lo) integ = lo;
+
+    u = fixSatAdd32(pd, integ);
+    if ((u > hi && e > 0) || (u < lo && e < 0))
+    {
+        integ = p_pid->integ;                   // 포화 방향 적분 중단
+        u     = fixSatAdd32(pd, integ);
+    }
+    p_pid->integ = integ;
+
+    if (u > hi) u = hi;
+    else if (u < lo) u = lo;
+
+    return (int16_t)((u + 128) >> 8);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                             LOOKUP INTERPOLATION                            */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  y[i] + (y[i+1] - y[i]) × frac / 2^shift (간격이 2^shift → 나눗셈 없음)
+ */
+int16_t fixLutInterp(const fix_lut_t *p_lut, int16_t x)
+{
+    uint16_t dx, idx, frac;
+    int16_t  y0, y1;
+
+    if (x <= p_lut->x0) return p_lut->y[0];
+
+    dx   = (uint16_t)((int32_t)x - p_lut->x0);
+    idx  = dx >> p_lut->shift;
+    if (idx >= (uint16_t)(p_lut->n - 1)) return p_lut->y[p_lut->n - 1];
+
+    frac = dx & ((1U << p_lut->shift) - 1);
+    y0   = p_lut->y[idx];
+    if (frac == 0) return y0;
+
+    y1   = p_lut->y[idx + 1];
+
+    // |y1 - y0| ≤ 65535, frac < 2^15 → < 2^31
+    return (int16_t)(y0 + ((((int32_t)y1 - y0) * frac + (1L << (p_lut->shift - 1))) >> p_lut->shift));
+}
@@ -0,0 +1,98 @@
+/*
+ * File: trace.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: Low-overhead timestamped event trace
+ *              RAM 링버퍼 관리 및 UART 바이너리 덤프.
+ *              기록 자체는 trace.h 의 inline traceRecord() 에서 수행.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                                */
+/* -------------------------------------------------------------------------- */
+#include "trace.h"
+#include "uart.h"    // 덤프 출력
+
+
+/* -------------------------------------------------------------------------- */
+/*                               TRACE BUFFER                                  */
+/* -------------------------------------------------------------------------- */
+trace_evt_t      trace_buf[TRACE_BUF_SIZE];   // 이벤트 링버퍼
+volatile uint8_t trace_head    = 0;           // 다음 기록 위치 (= 가장 오래된 이벤트)
+volatile bool    trace_enabled = false;       // 기록 활성화
+
+
+/* -------------------------------------------------------------------------- */
+/*                               INTERNAL HELPERS                              */
+/* -------------------------------------------------------------------------- */
+static void traceWriteU16(uint16_t v)
+{
+    uartWrite((char)(v & 0xFF));
+    uartWrite((char)(v >> 8));
+}
+
+static void traceClear(void)
+{
+    for (uint16_t i = 0; i < TRACE_BUF_SIZE; i++)
+        trace_buf[i].id = TRACE_ID_EMPTY;
+
+    trace_head = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                 TRACE API                                   */
+/* -------------------------------------------------------------------------- */
+/**
+ * @brief  Clear buffer and start recording
+ */
+void traceInit(void)
+{
+    traceEnable(false);
+    traceClear();
+    traceEnable(true);
+}
+
+/**
+ * @brief  Enable / disable recording
+ */
+void traceEnable(bool enable)
+{
+    trace_enabled = enable;
+}
+
+/**
+ * @brief  Dump buffered events over UART (binary) and clear buffer
+ */
+void traceDump(void)
+{
+    bool     was_enabled = trace_enabled;
+    uint16_t count = 0;
+    uint8_t  idx;
+
+    traceEnable(false);   // 덤프 중 기록 정지 (uart 이벤트 재귀 방지)
+
+    for (uint16_t i = 0; i < TRACE_BUF_SIZE; i++)
+    {
+        if (trace_buf[i].id != TRACE_ID_EMPTY) count++;
+    }
+
+    uartPrint("TRC2");
+    traceWriteU16(count);
+    uartWrite(4);                             // tick 단위 [µs]
+
+    idx = trace_head;                         // 가장 오래된 슬롯 (미기록이면 빈 슬롯)
+    for (uint16_t i = 0; i < TRACE_BUF_SIZE; i++)
+    {
+        if (trace_buf[idx].id != TRACE_ID_EMPTY)
+        {
+            uartWrite((char)trace_buf[idx].id);
+            traceWriteU16(trace_buf[idx].ms);
+            uartWrite((char)trace_buf[idx].tick);
+        }
+        idx = (idx + 1) & TRACE_BUF_MASK;
+    }
+
+    traceClear();
+
+    traceEnable(was_enabled);
+}
@@ -0,0 +1,106 @@
+/*
+ * File: test_main.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: app.c unit test (pio test -e native)
+ *              실제 appInit()/appTask() 를 가상 시계로 실행하고
+ *              host GPIO 레지스터(gpioHostGetOutput 등)로 결과를 확인한다.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include <unity.h>
+#include "app.h"
+#include "gpio.h"
+#include "delay.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  FIXTURE                                   */
+/* -------------------------------------------------------------------------- */
+void setUp(void)
+{
+    appInit();                    // delayInit() → 가상 시계 0
+    delayHostSetVirtual(true);
+}
+
+void tearDown(void)
+{
+    delayHostSetVirtual(false);
+}
+
+/**
+ * @brief  1ms 씩 진행하며 appTask() 호출 (main loop 대체)
+ */
+static void runMs(uint32_t ms)
+{
+    while (ms--)
+    {
+        delayHostAdvanceUs(1000);
+        appTask();
+    }
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                TEST CASES                                  */
+/* -------------------------------------------------------------------------- */
+static void test_init_applies_pin_modes(void)
+{
+    TEST_ASSERT_EQUAL_INT(GPIO_OUTPUT, gpioHostGetMode(GPIO_LED));
+    TEST_ASSERT_EQUAL_INT(GPIO_INPUT,  gpioHostGetMode(GPIO_BUTTON));
+    TEST_ASSERT_EQUAL_UINT8(1, gpioHostGetOutput(GPIO_BUTTON));     // 풀업 (PORTx = 1)
+    TEST_ASSERT_EQUAL_UINT8(0, gpioHostGetOutput(GPIO_LED));
+}
+
+static void test_led_toggles_every_500ms(void)
+{
+    runMs(499);
+    TEST_ASSERT_EQUAL_UINT8(0, gpioHostGetOutput(GPIO_LED));
+
+    runMs(1);                     // task_500ms
+    TEST_ASSERT_EQUAL_UINT8(1, gpioHostGetOutput(GPIO_LED));
+
+    runMs(499);
+    TEST_ASSERT_EQUAL_UINT8(1, gpioHostGetOutput(GPIO_LED));
+
+    runMs(1);
+    TEST_ASSERT_EQUAL_UINT8(0, gpioHostGetOutput(GPIO_LED));
+}
+
+static void test_late_dispatch_does_not_double_run(void)
+{
+    // main loop 가 2.3s 동안 멈춘 뒤 재개 → task_500ms 는 1회만 실행 (밀린 횟수 누적 안 함)
+    delayHostAdvanceUs(2300000UL);
+    appTask();
+    TEST_ASSERT_EQUAL_UINT8(1, gpioHostGetOutput(GPIO_LED));
+
+    appTask();
+    TEST_ASSERT_EQUAL_UINT8(1, gpioHostGetOutput(GPIO_LED));
+
+    runMs(500);
+    TEST_ASSERT_EQUAL_UINT8(0, gpioHostGetOutput(GPIO_LED));
+}
+
+static void test_input_follows_host_level(void)
+{
+    gpioHostSetInput(GPIO_BUTTON, GPIO_HIGH);
+    TEST_ASSERT_EQUAL_UINT8(1, gpioRead(GPIO_BUTTON));
+
+    gpioHostSetInput(GPIO_BUTTON, GPIO_LOW);
+    TEST_ASSERT_EQUAL_UINT8(0, gpioRead(GPIO_BUTTON));
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_init_applies_pin_modes);
+    RUN_TEST(test_led_toggles_every_500ms);
+    RUN_TEST(test_late_dispatch_does_not_double_run);
+    RUN_TEST(test_input_follows_host_level);
+    return UNITY_END();
+}
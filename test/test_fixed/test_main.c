@@ -0,0 +1,355 @@
+/*
+ * File: test_main.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: fixed.h unit test (pio test -e native)
+ *              같은 양자화 계수를 쓴 double 기준 연산과 비교하여
+ *              fixed.h 머리말에 적힌 오차 한계를 확인한다.
+ *              입력은 고정 seed LCG → 매 실행 동일.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include <unity.h>
+#include <stdio.h>
+#include "fixed.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  HELPERS                                   */
+/* -------------------------------------------------------------------------- */
+#define TEST_N          20000   // 난수 비교 횟수
+#define ERR_EPS         1e-9    // double 비교 여유
+
+static uint32_t lcg_state;
+
+void setUp(void)
+{
+    lcg_state = 12345;
+}
+
+void tearDown(void)
+{
+}
+
+static int16_t rnd16(void)
+{
+    lcg_state = lcg_state * 1103515245UL + 12345UL;
+    return (int16_t)(lcg_state >> 16);
+}
+
+/* [lo, hi] 균등 */
+static int16_t rndRange(int16_t lo, int16_t hi)
+{
+    return (int16_t)(lo + (int32_t)((uint16_t)rnd16() % (uint16_t)(hi - lo + 1)));
+}
+
+static double absd(double x)
+{
+    return (x < 0) ? -x : x;
+}
+
+static double clampd(double x, double lo, double hi)
+{
+    return (x < lo) ? lo : (x > hi) ? hi : x;
+}
+
+/* 최대 오차가 한계 이내인지 확인 (실패 시 값 출력) */
+static void assertErr(const char *name, double max_err, double bound)
+{
+    char msg[96];
+
+    snprintf(msg, sizeof(msg), "%s: max err %.4f LSB > %.2f", name, max_err, bound);
+    TEST_ASSERT_TRUE_MESSAGE(max_err <= bound + ERR_EPS, msg);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                           SATURATING ARITHMETIC                            */
+/* -------------------------------------------------------------------------- */
+static void test_sat_add(void)
+{
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q15Add(Q15(0.75), Q15(0.5)));
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, q15Sub(Q15(-0.75), Q15(0.5)));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q15Neg(INT16_MIN));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q15Abs(INT16_MIN));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, fixSatAdd32(INT32_MAX - 5, 10));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, fixSatAdd32(INT32_MIN + 5, -10));
+    TEST_ASSERT_EQUAL_INT32(-1, fixSatAdd32(INT32_MAX, INT32_MIN));
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        int16_t a = rnd16();
+        int16_t b = rnd16();
+        double  r = clampd((double)a + b, INT16_MIN, INT16_MAX);
+
+        TEST_ASSERT_EQUAL_INT16((int16_t)r, q15Add(a, b));
+        TEST_ASSERT_EQUAL_INT16((int16_t)clampd((double)a - b, INT16_MIN, INT16_MAX), q15Sub(a, b));
+        TEST_ASSERT_EQUAL_INT16((int16_t)r, q78Add(a, b));
+    }
+}
+
+static void test_sat_mul(void)
+{
+    double e15 = 0, e78 = 0, ediv = 0;
+
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q15Mul(INT16_MIN, INT16_MIN));   // -1 × -1
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q78Mul(Q7_8(100.0), Q7_8(2.0)));
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN, q78Mul(Q7_8(-100.0), Q7_8(2.0)));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, q78Div(Q7_8(1.0), 0));
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        int16_t a = rnd16();
+        int16_t b = rnd16();
+        int16_t d = rnd16();
+        double  r;
+
+        r   = clampd((double)a * b / 32768.0, INT16_MIN, INT16_MAX);
+        e15 = (absd(q15Mul(a, b) - r) > e15) ? absd(q15Mul(a, b) - r) : e15;
+
+        r   = clampd((double)a * b / 256.0, INT16_MIN, INT16_MAX);
+        e78 = (absd(q78Mul(a, b) - r) > e78) ? absd(q78Mul(a, b) - r) : e78;
+
+        if (d == 0) continue;
+        r    = clampd((double)a * 256.0 / d, INT16_MIN, INT16_MAX);
+        ediv = (absd(q78Div(a, d) - r) > ediv) ? absd(q78Div(a, d) - r) : ediv;
+    }
+
+    assertErr("q15Mul", e15, 0.5);
+    assertErr("q78Mul", e78, 0.5);
+    assertErr("q78Div", ediv, 0.5);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  FILTERS                                   */
+/* -------------------------------------------------------------------------- */
+static void test_moving_average(void)
+{
+    int16_t  buf[16];
+    int16_t  hist[16];
+    fix_ma_t ma;
+    double   max_err = 0;
+
+    fixMaInit(&ma, buf, 4, 100);
+    for (uint8_t i = 0; i < 16; i++) hist[i] = 100;
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        int16_t x = rnd16();
+        double  sum = 0;
+        int16_t y;
+
+        hist[i & 15] = x;
+        y = fixMaUpdate(&ma, x);
+
+        for (uint8_t k = 0; k < 16; k++) sum += hist[k];
+        if (absd(y - sum / 16.0) > max_err) max_err = absd(y - sum / 16.0);
+    }
+
+    assertErr("fixMaUpdate", max_err, 0.5);
+}
+
+static void checkIir(q15_t alpha, const char *name)
+{
+    fix_iir_t iir;
+    double    yd = 0;
+    double    a  = alpha / 32768.0;
+    double    max_err = 0;
+    int16_t   x = 0;
+
+    fixIirInit(&iir, alpha, 0);
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        int16_t y;
+
+        if ((i % 500) == 0) x = rndRange(-20000, 20000);   // 계단 + 잡음
+        x = (int16_t)(x + rndRange(-50, 50));
+
+        y   = fixIirUpdate(&iir, x);
+        yd += a * ((double)x - yd);
+        if (absd(y - yd) > max_err) max_err = absd(y - yd);
+    }
+
+    assertErr(name, max_err, 1.0);
+    TEST_ASSERT_TRUE_MESSAGE(max_err < 1.0, name);      // 머리말: < 1 LSB
+}
+
+static void test_iir(void)
+{
+    checkIir(Q15(0.1),   "fixIirUpdate alpha 0.1");
+    checkIir(Q15(0.001), "fixIirUpdate alpha 0.001");
+    checkIir(Q15(0.9),   "fixIirUpdate alpha 0.9");
+}
+
+static void test_iir_no_deadband(void)
+{
+    fix_iir_t iir;
+    int16_t   y = 0;
+
+    // alpha × 1 < 1 LSB 라도 잔차 누적으로 결국 목표에 도달
+    fixIirInit(&iir, Q15(0.001), 0);
+    for (uint32_t i = 0; i < 20000; i++)
+        y = fixIirUpdate(&iir, 1);
+
+    TEST_ASSERT_EQUAL_INT16(1, y);
+}
+
+static void test_biquad(void)
+{
+    /* Butterworth LP, fc = fs/20 (머리말 오차 조건) */
+    const q14_t  b0 = Q14(0.0200833656), b1 = Q14(0.0401667311), b2 = Q14(0.0200833656);
+    const q14_t  a1 = Q14(-1.5610180758), a2 = Q14(0.6413515381);
+    fix_biquad_t bq;
+    double       x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    double       max_err = 0;
+    int16_t      x = 0;
+
+    fixBiquadInit(&bq, b0, b1, b2, a1, a2);
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        double  yd;
+        int16_t y;
+
+        if ((i % 400) == 0) x = rndRange(-15000, 15000);
+        x = (int16_t)(x + rndRange(-200, 200));
+
+        y  = fixBiquadUpdate(&bq, x);
+        yd = (b0 * (double)x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2) / 16384.0;
+        x2 = x1; x1 = x;
+        y2 = y1; y1 = yd;
+
+        if (absd(y - yd) > max_err) max_err = absd(y - yd);
+    }
+
+    assertErr("fixBiquadUpdate", max_err, 2.0);
+    TEST_ASSERT_TRUE_MESSAGE(max_err < 2.0, "fixBiquadUpdate");   // 머리말: < 2 LSB
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                    PID                                     */
+/* -------------------------------------------------------------------------- */
+static void test_pid_matches_reference(void)
+{
+    const q7_8_t kp = Q7_8(1.5), ki = Q7_8(0.05), kd = Q7_8(0.5);
+    const double lo = -1000 * 256.0, hi = 1000 * 256.0;
+    fix_pid_t    pid;
+    double       integ = 0, prev = 0;
+    double       max_err = 0;
+    uint32_t     n_lin = 0;
+    bool         first = true;
+    int16_t      pv = 0;
+    int16_t      out = 0;
+
+    fixPidInit(&pid, kp, ki, kd, -1000, 1000);
+
+    for (uint32_t i = 0; i < TEST_N; i++)
+    {
+        int16_t sp = (int16_t)(((i / 1000) & 1) ? 300 : -300);
+        double  e, dpv, pd, it, u;
+
+        // 1차 지연 plant + 잡음 (폐루프 → 대부분 비포화, 목표 전환 직후만 포화)
+        pv  = (int16_t)(pv + (out - pv) / 4 + rndRange(-20, 20));
+        out = fixPidUpdate(&pid, sp, pv);
+
+        // double 기준: 같은 Q8 스케일, 같은 anti-windup 규칙
+        e   = (double)sp - pv;
+        dpv = first ? 0 : (double)pv - prev;
+        pd  = kp * e - kd * dpv;
+        it  = clampd(integ + ki * e, lo, hi);
+        u   = pd + it;
+        if ((u > hi && e > 0) || (u < lo && e < 0))
+        {
+            it = integ;
+            u  = pd + it;
+        }
+        integ = it;
+        prev  = pv;
+        first = false;
+
+        if (u > lo && u < hi)           // 출력 포화 전 구간
+        {
+            n_lin++;
+            if (absd(out - u / 256.0) > max_err) max_err = absd(out - u / 256.0);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_INT16((u >= hi) ? 1000 : -1000, out);
+        }
+    }
+
+    TEST_ASSERT_TRUE(n_lin > TEST_N / 2);
+    assertErr("fixPidUpdate", max_err, 0.5);
+}
+
+static void test_pid_anti_windup(void)
+{
+    fix_pid_t pid;
+    int16_t   out = 0;
+
+    fixPidInit(&pid, Q7_8(1.0), Q7_8(0.5), 0, -100, 100);
+
+    // 도달 불가 목표 → 출력 포화 유지
+    for (uint16_t i = 0; i < 5000; i++)
+        out = fixPidUpdate(&pid, 1000, 0);
+    TEST_ASSERT_EQUAL_INT16(100, out);
+    TEST_ASSERT_TRUE(pid.integ <= 100L * 256);          // 적분이 출력 범위 밖으로 쌓이지 않음
+
+    // 목표 반전 → windup 이 없으면 첫 샘플부터 포화 해제
+    out = fixPidUpdate(&pid, -20, 0);
+    TEST_ASSERT_TRUE(out < 100);
+
+    for (uint16_t i = 0; i < 500; i++)
+        out = fixPidUpdate(&pid, -20, 0);
+    TEST_ASSERT_EQUAL_INT16(-100, out);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                             LUT INTERPOLATION                              */
+/* -------------------------------------------------------------------------- */
+static void test_lut_interp(void)
+{
+    static const int16_t y[] = { -30000, -1000, 0, 7, 4000, 32767, 32767, -32768, 5 };
+    const fix_lut_t      lut = { y, 9, 6, -200 };           // x = -200 + i × 64
+    double               max_err = 0;
+
+    TEST_ASSERT_EQUAL_INT16(y[0], fixLutInterp(&lut, INT16_MIN));
+    TEST_ASSERT_EQUAL_INT16(y[0], fixLutInterp(&lut, -200));
+    TEST_ASSERT_EQUAL_INT16(y[8], fixLutInterp(&lut, -200 + 8 * 64));
+    TEST_ASSERT_EQUAL_INT16(y[8], fixLutInterp(&lut, INT16_MAX));
+
+    for (int32_t x = -200; x <= -200 + 8 * 64; x++)
+    {
+        int32_t i  = (x + 200) / 64;
+        double  yd = (i >= 8) ? y[8] : y[i] + (double)(y[i + 1] - y[i]) * ((x + 200) - i * 64) / 64.0;
+        int16_t yf = fixLutInterp(&lut, (int16_t)x);
+
+        if (absd(yf - yd) > max_err) max_err = absd(yf - yd);
+    }
+
+    assertErr("fixLutInterp", max_err, 0.5);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sat_add);
+    RUN_TEST(test_sat_mul);
+    RUN_TEST(test_moving_average);
+    RUN_TEST(test_iir);
+    RUN_TEST(test_iir_no_deadband);
+    RUN_TEST(test_biquad);
+    RUN_TEST(test_pid_matches_reference);
+    RUN_TEST(test_pid_anti_windup);
+    RUN_TEST(test_lut_interp);
+    return UNITY_END();
+}
@@ -0,0 +1,240 @@
+/*
+ * File: test_main.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: keypad.c unit test (pio test -e native)
+ *              host GPIO 레지스터 위에 키 매트릭스를 흉내 낸다:
+ *              keypad.c 가 DDR 로 Low 구동한 행에서 눌린 키를 따라 연결된
+ *              행/열을 모두 Low 로 전파 → 실제 보드와 같은 ghost 경로가 생김.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include <unity.h>
+#include <string.h>
+#include "keypad.h"
+#include "gpio.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                               MATRIX MODEL                                 */
+/* -------------------------------------------------------------------------- */
+#define KP_X_ID(id)     id,
+static const gpio_id_t row_id[] = { APP_KEYPAD_ROWS(KP_X_ID) };
+static const gpio_id_t col_id[] = { APP_KEYPAD_COLS(KP_X_ID) };
+#undef KP_X_ID
+
+static bool key_down[KEYPAD_ROWS][KEYPAD_COLS];     // 물리적으로 눌린 키
+
+/**
+ * @brief  구동 중인 행(DDR = 출력)에서 눌린 키를 따라 Low 를 전파하고 열 입력 설정
+ */
+static void matrixApply(void)
+{
+    bool row_low[KEYPAD_ROWS];
+    bool col_low[KEYPAD_COLS] = { false };
+    bool changed = true;
+
+    for (uint8_t r = 0; r < KEYPAD_ROWS; r++)
+        row_low[r] = (gpioHostGetMode(row_id[r]) == GPIO_OUTPUT);
+
+    while (changed)
+    {
+        changed = false;
+        for (uint8_t r = 0; r < KEYPAD_ROWS; r++)
+        {
+            for (uint8_t c = 0; c < KEYPAD_COLS; c++)
+            {
+                if (!key_down[r][c] || row_low[r] == col_low[c]) continue;
+                row_low[r] = col_low[c] = true;
+                changed = true;
+            }
+        }
+    }
+
+    for (uint8_t c = 0; c < KEYPAD_COLS; c++)
+        gpioHostSetInput(col_id[c], col_low[c] ? GPIO_LOW : GPIO_HIGH);
+}
+
+/**
+ * @brief  task_1ms 대체: 1 tick = 행 1개 scan
+ */
+static void scanTicks(uint16_t ticks)
+{
+    while (ticks--)
+    {
+        matrixApply();
+        keypadScan();
+    }
+}
+
+/* 모든 행을 n 번 sample (debounce 4회 = scanSweeps(4)) */
+static void scanSweeps(uint8_t n)
+{
+    scanTicks((uint16_t)n * KEYPAD_ROWS);
+}
+
+static void press(uint8_t row, uint8_t col)     { key_down[row][col] = true; }
+static void release(uint8_t row, uint8_t col)   { key_down[row][col] = false; }
+
+static void expectEvent(uint8_t row, uint8_t col, bool pressed)
+{
+    keypad_evt_t evt;
+
+    TEST_ASSERT_TRUE_MESSAGE(keypadRead(&evt), "event missing");
+    TEST_ASSERT_EQUAL_UINT8(KEYPAD_KEY(row, col), evt.key);
+    TEST_ASSERT_EQUAL(pressed, evt.pressed);
+}
+
+static void expectNoEvent(void)
+{
+    keypad_evt_t evt;
+
+    TEST_ASSERT_FALSE(keypadRead(&evt));
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  FIXTURE                                   */
+/* -------------------------------------------------------------------------- */
+void setUp(void)
+{
+    memset(key_down, 0, sizeof(key_down));
+    gpioInit();
+    matrixApply();
+    TEST_ASSERT_TRUE(keypadInit());
+}
+
+void tearDown(void)
+{
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                TEST CASES                                  */
+/* -------------------------------------------------------------------------- */
+static void test_press_needs_four_samples(void)
+{
+    press(1, 2);
+    scanSweeps(3);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(keypadIsPressed(KEYPAD_KEY(1, 2)));
+
+    scanSweeps(1);
+    expectEvent(1, 2, true);
+    TEST_ASSERT_TRUE(keypadIsPressed(KEYPAD_KEY(1, 2)));
+
+    release(1, 2);
+    scanSweeps(3);
+    expectNoEvent();
+
+    scanSweeps(1);
+    expectEvent(1, 2, false);
+    expectNoEvent();
+}
+
+static void test_bounce_restarts_count(void)
+{
+    // 3 sample 눌림 → 1 sample 뗌 → 다시 3 sample: 연속 4회가 아니므로 이벤트 없음
+    press(2, 0);
+    scanSweeps(3);
+    release(2, 0);
+    scanSweeps(1);
+    press(2, 0);
+    scanSweeps(3);
+    expectNoEvent();
+
+    scanSweeps(1);
+    expectEvent(2, 0, true);
+}
+
+static void test_ghost_holds_fourth_key_until_resolved(void)
+{
+    uint16_t ghost = keypadGetGhostCount();
+
+    press(0, 0);
+    press(0, 1);
+    scanSweeps(4);
+    expectEvent(0, 0, true);
+    expectEvent(0, 1, true);
+
+    // 사각형 3번째 키 → 행 1 은 (1,0) 과 ghost (1,1) 을 함께 읽음 → 눌림 보류
+    press(1, 0);
+    scanSweeps(8);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(keypadIsPressed(KEYPAD_KEY(1, 0)));
+    TEST_ASSERT_FALSE(keypadIsPressed(KEYPAD_KEY(1, 1)));
+    TEST_ASSERT_EQUAL_UINT16(ghost + 1, keypadGetGhostCount());
+
+    // (0,1) 뗌 → 사각형 해소 → 실제 키 (1,0) 만 전달, (1,1) 은 끝까지 보고되지 않음
+    release(0, 1);
+    scanSweeps(4);
+    expectEvent(0, 1, false);
+    expectEvent(1, 0, true);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(keypadIsPressed(KEYPAD_KEY(1, 1)));
+}
+
+static void test_release_delivered_while_ghosted(void)
+{
+    press(1, 2);
+    scanSweeps(4);
+    expectEvent(1, 2, true);
+
+    press(0, 0);
+    press(0, 1);
+    scanSweeps(4);
+    expectEvent(0, 0, true);
+    expectEvent(0, 1, true);
+
+    press(1, 0);                                // 행 0/1 사각형 → 새 눌림 보류
+    scanSweeps(4);
+    expectNoEvent();
+
+    // ghost 가 남아 있는 동안에도 뗌은 바로 전달
+    release(1, 2);
+    scanSweeps(4);
+    expectEvent(1, 2, false);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(keypadIsPressed(KEYPAD_KEY(1, 2)));
+}
+
+static void test_queue_overflow_counted(void)
+{
+    uint16_t ovf = keypadGetOverflow();
+
+    // 눌림/뗌 KEYPAD_QUEUE_SIZE 이벤트, 큐는 (KEYPAD_QUEUE_SIZE - 1) 개만 저장 → 1개 버림
+    for (uint8_t i = 0; i < KEYPAD_QUEUE_SIZE / 2; i++)
+    {
+        press(3, 3);
+        scanSweeps(4);
+        release(3, 3);
+        scanSweeps(4);
+    }
+    TEST_ASSERT_EQUAL_UINT16(ovf + 1, keypadGetOverflow());
+
+    for (uint8_t i = 0; i < KEYPAD_QUEUE_SIZE - 1; i++)
+        expectEvent(3, 3, (i & 1) == 0);
+    expectNoEvent();
+
+    // 비운 뒤에는 정상 저장
+    press(3, 3);
+    scanSweeps(4);
+    expectEvent(3, 3, true);
+    TEST_ASSERT_EQUAL_UINT16(ovf + 1, keypadGetOverflow());
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_press_needs_four_samples);
+    RUN_TEST(test_bounce_restarts_count);
+    RUN_TEST(test_ghost_holds_fourth_key_until_resolved);
+    RUN_TEST(test_release_delivered_while_ghosted);
+    RUN_TEST(test_queue_overflow_counted);
+    return UNITY_END();
+}
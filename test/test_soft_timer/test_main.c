@@ -0,0 +1,135 @@
+/*
+ * File: test_main.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: soft_timer unit test (pio test -e native)
+ *              가상 시계(delayHostSetVirtual/delayHostAdvanceUs)로 시간을 진행하여
+ *              만료 시점을 결정적으로 검사한다.
+ */
+
+/* -------------------------------------------------------------------------- */
+/*                                INCLUDE FILES                               */
+/* -------------------------------------------------------------------------- */
+#include <unity.h>
+#include "delay.h"
+#include "soft_timer.h"
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  FIXTURE                                   */
+/* -------------------------------------------------------------------------- */
+void setUp(void)
+{
+    delayInit();                  // 가상 시계 0 부터 시작
+    delayHostSetVirtual(true);
+}
+
+void tearDown(void)
+{
+    delayHostSetVirtual(false);
+}
+
+static void advanceMs(uint32_t ms)
+{
+    delayHostAdvanceUs(ms * 1000UL);
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                TEST CASES                                  */
+/* -------------------------------------------------------------------------- */
+static void test_virtual_clock_advances_only_on_request(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, millis());
+    TEST_ASSERT_EQUAL_UINT32(0, micros());
+
+    delayHostAdvanceUs(1500);
+    TEST_ASSERT_EQUAL_UINT32(1, millis());
+    TEST_ASSERT_EQUAL_UINT32(1500, micros());
+
+    delay_ms(10);                 // 가상 시계: 대기 없이 즉시 진행
+    TEST_ASSERT_EQUAL_UINT32(11, millis());
+}
+
+static void test_one_shot_expires_at_interval(void)
+{
+    soft_timer_t tmr;
+
+    softTimerStart(&tmr, 100);
+
+    advanceMs(99);
+    TEST_ASSERT_FALSE(softTimerIsElapsed(&tmr));
+
+    advanceMs(1);
+    TEST_ASSERT_TRUE(softTimerIsElapsed(&tmr));
+
+    advanceMs(50);                // one-shot: start 유지 → 계속 만료 상태
+    TEST_ASSERT_TRUE(softTimerIsElapsed(&tmr));
+}
+
+static void test_restart_uses_current_time(void)
+{
+    soft_timer_t tmr;
+
+    softTimerStart(&tmr, 100);
+    advanceMs(80);
+    softTimerRestart(&tmr);
+
+    advanceMs(99);
+    TEST_ASSERT_FALSE(softTimerIsElapsed(&tmr));
+    advanceMs(1);
+    TEST_ASSERT_TRUE(softTimerIsElapsed(&tmr));
+}
+
+static void test_periodic_keeps_phase(void)
+{
+    soft_timer_t tmr;
+    uint32_t     fired = 0;
+
+    softTimerStart(&tmr, 10);
+
+    // 3ms 늦게 확인해도 다음 만료는 start + 2 * interval (누적 지연 없음)
+    advanceMs(13);
+    TEST_ASSERT_TRUE(softTimerIsElapsedAndReset(&tmr));
+    TEST_ASSERT_FALSE(softTimerIsElapsedAndReset(&tmr));
+
+    advanceMs(6);                 // t = 19
+    TEST_ASSERT_FALSE(softTimerIsElapsedAndReset(&tmr));
+    advanceMs(1);                 // t = 20
+    TEST_ASSERT_TRUE(softTimerIsElapsedAndReset(&tmr));
+
+    // 1ms 간격 polling 1초 → 정확히 100회
+    softTimerStart(&tmr, 10);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        advanceMs(1);
+        if (softTimerIsElapsedAndReset(&tmr)) fired++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, fired);
+}
+
+static void test_timeout_helpers(void)
+{
+    uint32_t start = millis();
+
+    advanceMs(49);
+    TEST_ASSERT_EQUAL_UINT32(49, timeElapsed(start));
+    TEST_ASSERT_FALSE(timeIsTimeout(start, 50));
+
+    advanceMs(1);
+    TEST_ASSERT_TRUE(timeIsTimeout(start, 50));
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                   MAIN                                     */
+/* -------------------------------------------------------------------------- */
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_virtual_clock_advances_only_on_request);
+    RUN_TEST(test_one_shot_expires_at_interval);
+    RUN_TEST(test_restart_uses_current_time);
+    RUN_TEST(test_periodic_keeps_phase);
+    RUN_TEST(test_timeout_helpers);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+File: bench.py
+Author: Young Kwan CHO, Lilith
+Description: env:bench 펌웨어를 simavr에서 실행하여 hot-path 별
+             cycles/call 과 함수 코드 크기(avr-nm)를 수집하고
+             베이스라인(tools/bench_baseline.csv)과의 차이를 출력한다.
+
+Usage:
+  pio run -e bench && python tools/bench.py            # 측정 + 베이스라인 비교
+  python tools/bench.py --save                         # 베이스라인 갱신 (없으면 비교 시 exit 1)
+  python tools/bench.py --fail-over 5                  # cycles/size 5% 초과 증가 시 exit 1
+  pio run -e native_bench && python tools/bench.py --native   # host ns/call (크기 비교 없음)
+
+필요 도구: simavr, avr-nm (PlatformIO toolchain-atmelavr/bin 을 PATH에 추가)
+"""
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ELF = os.path.join(ROOT, ".pio", "build", "bench", "firmware.elf")
+NATIVE = os.path.join(ROOT, ".pio", "build", "native_bench", "program")
+BASELINE = os.path.join(ROOT, "tools", "bench_baseline.csv")
+
+LINE_RE = re.compile(r"BENCH,([A-Za-z_]\w*),(\d+),(\d+),([A-Za-z_]\w*)")
+UNIT_RE = re.compile(r"BENCH_UNIT,(\w+)")
+
+
+def run_target(args):
+    if args.native:
+        cmd = [args.program or NATIVE]
+    else:
+        cmd = [args.simavr, "-m", "atmega128", "-f", str(args.f_cpu), args.elf]
+    try:
+        out = subprocess.run(cmd, capture_output=True, text=True,
+                             errors="replace", timeout=args.timeout)
+    except FileNotFoundError:
+        sys.exit("cannot run %s (빌드 또는 PATH 확인)" % cmd[0])
+    except subprocess.TimeoutExpired as e:
+        out = e   # 출력이 있으면 부분 결과라도 사용
+    text = (out.stdout or "") + (out.stderr or "")
+    if isinstance(text, bytes):
+        text = text.decode(errors="replace")
+    text = re.sub(r"\x1b\[[0-9;]*m", "", text)   # simavr 색상 코드 제거
+
+    unit = UNIT_RE.search(text)
+    results = {}
+    symbols = {}
+    for m in LINE_RE.finditer(text):
+        results[m.group(1)] = (int(m.group(2)), int(m.group(3)))
+        symbols[m.group(1)] = m.group(4)
+    if "BENCH_DONE" not in text:
+        print("warning: BENCH_DONE not seen, results may be partial", file=sys.stderr)
+    return (unit.group(1) if unit else "?"), results, symbols
+
+
+def symbol_sizes(elf, nm, symbols):
+    """항목 이름 → 코드 크기 [bytes] (avr-nm -S, 항목별 sym 으로 조회)
+       크기 비교가 조용히 빠지지 않도록 avr-nm 실패나 없는 심볼은 오류로 처리"""
+    table = {}
+    try:
+        out = subprocess.run([nm, "-S", "--size-sort", elf],
+                             capture_output=True, text=True, check=True).stdout
+    except (FileNotFoundError, subprocess.CalledProcessError):
+        sys.exit("cannot run %s (PlatformIO toolchain-atmelavr/bin 을 PATH에 추가)" % nm)
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in "tTwW":
+            table[parts[3]] = int(parts[1], 16)
+
+    missing = sorted("%s (%s)" % (name, sym) for name, sym in symbols.items() if sym not in table)
+    if missing:
+        sys.exit("symbol not found in %s: %s" % (os.path.relpath(elf, ROOT), ", ".join(missing)))
+    return {name: table[sym] for name, sym in symbols.items()}
+
+
+def load_baseline(path):
+    base = {}
+    if not os.path.exists(path):
+        return base
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            base[row["name"]] = row
+    return base
+
+
+def save_baseline(path, unit, results, sizes):
+    with open(path, "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(["name", "unit", "min", "max", "size"])
+        for name, (c_min, c_max) in results.items():
+            w.writerow([name, unit, c_min, c_max, sizes.get(name, "")])
+    print("baseline saved → %s" % os.path.relpath(path, ROOT))
+
+
+def delta(cur, old):
+    if old in (None, ""):
+        return "", 0.0
+    old = int(old)
+    d = cur - old
+    pct = (100.0 * d / old) if old else (0.0 if d == 0 else 100.0)
+    return "%+d (%+.1f%%)" % (d, pct), pct
+
+
+def print_results(unit, results, sizes, base):
+    """결과 표 출력 → 최대 증가율[%] 반환 (베이스라인에 없는 항목은 "new")"""
+    worst = 0.0
+    hdr = "%-28s %8s %8s %-18s %6s %-16s" % ("name", "min", "max", "d min", "size", "d size")
+    print("unit: %s" % unit)
+    print(hdr)
+    print("-" * len(hdr))
+    for name, (c_min, c_max) in results.items():
+        old = base.get(name, {})
+        size = sizes.get(name)
+        d_min, p_min = delta(c_min, old.get("min"))
+        d_size, p_size = delta(size, old.get("size")) if size is not None else ("", 0.0)
+        if base and not old:
+            d_min = "new"
+        worst = max(worst, p_min, p_size)
+        print("%-28s %8d %8d %-18s %6s %-16s" % (
+            name, c_min, c_max, d_min, "" if size is None else size, d_size))
+    return worst
+
+
+def main():
+    ap = argparse.ArgumentParser(description="HAL/scheduler hot-path benchmark")
+    ap.add_argument("--elf", default=ELF)
+    ap.add_argument("--simavr", default="simavr")
+    ap.add_argument("--nm", default="avr-nm")
+    ap.add_argument("--f-cpu", type=int, default=16000000)
+    ap.add_argument("--native", action="store_true", help="run env:native_bench program")
+    ap.add_argument("--program", help="native program path")
+    ap.add_argument("--baseline", default=BASELINE)
+    ap.add_argument("--save", action="store_true", help="write results as new baseline")
+    ap.add_argument("--fail-over", type=float, default=None,
+                    help="exit 1 if min cycles or size grows more than N%%")
+    ap.add_argument("--timeout", type=float, default=30.0)
+    args = ap.parse_args()
+
+    if args.native and args.baseline == BASELINE:
+        args.baseline = os.path.join(ROOT, "tools", "bench_baseline_native.csv")
+
+    unit, results, symbols = run_target(args)
+    if not results:
+        sys.exit("no BENCH lines in output")
+    sizes = {} if args.native else symbol_sizes(args.elf, args.nm, symbols)
+
+    if args.save:
+        save_baseline(args.baseline, unit, results, sizes)
+        return 0
+
+    base = load_baseline(args.baseline)
+    if not base:
+        # 비교 대상 없이 통과하면 회귀를 놓침 → 명시적으로 실패
+        print_results(unit, results, sizes, {})
+        sys.exit("no baseline: %s 없음 (같은 env 결과로 python tools/bench.py %s--save 후 커밋)"
+                 % (os.path.relpath(args.baseline, ROOT), "--native " if args.native else ""))
+
+    worst = print_results(unit, results, sizes, base)
+
+    if args.fail_over is not None and worst > args.fail_over:
+        print("REGRESSION: worst growth %.1f%% > %.1f%%" % (worst, args.fail_over))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
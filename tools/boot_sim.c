@@ -0,0 +1,253 @@
+/*
+ * File: boot_sim.c
+ * Author: Young Kwan CHO, Lilith
+ * Description: simavr(libsimavr) 위에서 UART 부트로더(env:boot) 를 실행하고
+ *              USART0 를 pty 로 연결 → tools/boot_upload.py 로 실제 갱신을 수행,
+ *              첫 BLOCK 수신 ~ app jump 까지의 시뮬레이션 시간(cycle / F_CPU)을 보고한다.
+ *              시뮬레이션은 실시간으로 제한 → 호스트 응답 지연이 보드와 같은 비율로 포함됨.
+ *
+ * Build (tools/boot_sim.py 가 자동으로 수행):
+ *   cc -O2 -o boot_sim tools/boot_sim.c $(pkg-config --cflags --libs simavr) -lelf
+ *
+ * Usage:
+ *   boot_sim <boot firmware.elf> [old_pages]
+ *     old_pages : 이전(더 긴) 이미지를 흉내 내어 page 1 ~ old_pages-1 을 0xA5 로 채움
+ *                 (page 0 은 비워 둠 → app 무효 → 부트로더가 'H' 를 계속 대기)
+ *
+ * Output (stdout, 한 줄씩):
+ *   BOOT_SIM,pty,<slave path>
+ *   BOOT_SIM,cycles,<첫 BLOCK ~ jump cycle>,<seconds>
+ *   BOOT_SIM,stale_pages,<0xA5 로 남아 있는 page 수>   (0 이어야 함)
+ *
+ * Note: simavr 의 SPM(page erase/write) 완료 시간은 데이터시트 값(최대 4.5ms)과 다를 수 있음
+ *       (즉시 완료로 처리하는 버전 있음) → flash 대기를 포함한 시간은 보드 실측으로 확인.
+ */
+
+#define _GNU_SOURCE                         // posix_openpt, cfmakeraw
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_irq.h>
+#include <simavr/avr_uart.h>
+
+
+#define SIM_F_CPU           16000000UL
+#define SIM_BOOT_START      0x1E000UL       // boot.c BOOT_APP_END
+#define SIM_PAGE            256
+#define SIM_FILL            0xA5
+#define SIM_POLL_CYCLES     160             // 1Mbaud 1 byte = 160 cycle
+#define SIM_TIMEOUT_S       60.0            // 시뮬레이션 시간 상한
+#define SIM_TAIL_CYCLES     32000           // jump 후 2ms 더 실행 → 마지막 ACK 송신 완료
+
+
+static int          pty_fd = -1;
+static bool         uart_xon = true;
+static bool         hello_seen;             // 'B' (HELLO 응답) 송신됨
+static bool         block_seen;
+static avr_cycle_count_t t_block;           // 호스트의 첫 BLOCK ('B') 수신 cycle
+
+
+/* -------------------------------------------------------------------------- */
+/*                                  UART <-> pty                              */
+/* -------------------------------------------------------------------------- */
+
+static void simUartOut(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    uint8_t ch = (uint8_t)value;
+    (void)irq; (void)param;
+
+    if (ch == 'B')
+        hello_seen = true;
+    if (write(pty_fd, &ch, 1) != 1)
+        perror("pty write");
+}
+
+static void simUartXon(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq; (void)value; (void)param;
+    uart_xon = true;
+}
+
+static void simUartXoff(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq; (void)value; (void)param;
+    uart_xon = false;
+}
+
+static double simWallSec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int simPtyOpen(void)
+{
+    struct termios tio;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (fd < 0 || grantpt(fd) || unlockpt(fd))
+        return -1;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/*                                      main                                  */
+/* -------------------------------------------------------------------------- */
+
+static uint16_t simStalePages(avr_t *avr)
+{
+    uint16_t n = 0;
+
+    for (uint32_t addr = 0; addr < SIM_BOOT_START; addr += SIM_PAGE)
+    {
+        uint16_t i;
+
+        for (i = 0; i < SIM_PAGE && avr->flash[addr + i] == SIM_FILL; i++);
+        if (i == SIM_PAGE) n++;
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    elf_firmware_t fw;
+    avr_t *avr;
+    uint32_t flags = 0;
+    avr_irq_t *irq_in;
+    avr_cycle_count_t next_poll = 0;
+    avr_cycle_count_t t_jump = 0;
+    long old_pages = 0;
+    int state;
+    double wall0;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <boot firmware.elf> [old_pages]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2)
+        old_pages = strtol(argv[2], NULL, 0);
+
+    memset(&fw, 0, sizeof(fw));
+    if (elf_read_firmware(argv[1], &fw))
+    {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+
+    avr = avr_make_mcu_by_name("atmega128");
+    if (!avr)
+        return 2;
+    avr_init(avr);
+    avr_load_firmware(avr, &fw);
+    avr->frequency = SIM_F_CPU;
+    avr->pc       = SIM_BOOT_START;         // BOOTRST fuse
+    avr->reset_pc = SIM_BOOT_START;
+
+    for (long pg = 1; pg < old_pages && pg * SIM_PAGE < (long)SIM_BOOT_START; pg++)
+        memset(avr->flash + pg * SIM_PAGE, SIM_FILL, SIM_PAGE);
+
+    // simavr 기본 stdio 출력 끄기 → 바이너리 프로토콜은 pty 로만
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+
+    pty_fd = simPtyOpen();
+    if (pty_fd < 0)
+    {
+        perror("pty");
+        return 2;
+    }
+    printf("BOOT_SIM,pty,%s\n", ptsname(pty_fd));
+    fflush(stdout);
+
+    irq_in = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT),
+                            simUartOut, NULL);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUT_XON),
+                            simUartXon, avr);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUT_XOFF),
+                            simUartXoff, avr);
+
+    wall0 = simWallSec();
+    for (;;)
+    {
+        state = avr_run(avr);
+        if (t_jump)
+        {
+            if (state == cpu_Done || state == cpu_Crashed || avr->cycle > t_jump + SIM_TAIL_CYCLES)
+                break;
+            continue;
+        }
+        if (state == cpu_Done || state == cpu_Crashed)
+        {
+            fprintf(stderr, "simavr stopped (state %d) at pc 0x%05x\n", state, (unsigned)avr->pc);
+            return 1;
+        }
+
+        if (avr->pc < SIM_BOOT_START)
+        {
+            if (!block_seen)
+            {
+                fprintf(stderr, "jumped to app before the first BLOCK\n");
+                return 1;
+            }
+            t_jump = avr->cycle;
+            continue;
+        }
+
+        if (avr->cycle >= next_poll)
+        {
+            uint8_t ch;
+            double ahead = (double)avr->cycle / SIM_F_CPU - (simWallSec() - wall0);
+
+            next_poll = avr->cycle + SIM_POLL_CYCLES;
+            if (ahead > 0.001)                  // 실시간보다 앞서면 대기
+                usleep((useconds_t)(ahead * 1e6));
+
+            if (uart_xon && read(pty_fd, &ch, 1) == 1)
+            {
+                if (!block_seen && hello_seen && ch == 'B')
+                {
+                    block_seen = true;
+                    t_block = avr->cycle;
+                }
+                avr_raise_irq(irq_in, ch);
+            }
+        }
+
+        if (avr->cycle > (avr_cycle_count_t)(SIM_TIMEOUT_S * SIM_F_CPU))
+        {
+            fprintf(stderr, "timeout: no app jump within %.0f s simulated\n", SIM_TIMEOUT_S);
+            return 1;
+        }
+    }
+
+    printf("BOOT_SIM,cycles,%llu,%.4f\n",
+           (unsigned long long)(t_jump - t_block),
+           (double)(t_jump - t_block) / SIM_F_CPU);
+    printf("BOOT_SIM,stale_pages,%u\n", simStalePages(avr));
+    fflush(stdout);
+
+    usleep(200 * 1000);                     // 호스트가 마지막 ACK 를 읽을 시간
+    close(pty_fd);
+    return 0;
+}
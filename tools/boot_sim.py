@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+File: boot_sim.py
+Author: Young Kwan CHO, Lilith
+Description: UART 부트로더 갱신 시간을 simavr 에서 실측한다.
+             tools/boot_sim.c (libsimavr, USART0 ↔ pty) 를 빌드/실행하고
+             그 pty 로 tools/boot_upload.py 를 실행 → 실제 프로토콜로 app 이미지를 기록,
+             첫 BLOCK ~ app jump 시뮬레이션 시간과 남은 이전 이미지 page 수를 출력한다.
+
+Usage:
+  pio run -e boot && pio run -e ATmega128 && python tools/boot_sim.py
+  python tools/boot_sim.py --old-pages 480          # 이전 이미지가 app 영역 전체 → 잔여 page 0 확인
+  python tools/boot_sim.py --image firmware.bin --boot-elf boot.elf
+
+필요: simavr 개발 패키지 (pkg-config simavr, libelf), pyserial
+주의: simavr 의 SPM erase/write 완료 시간은 데이터시트 값과 다를 수 있음 (즉시 완료 처리 버전 있음)
+      → flash 대기(page 당 최대 9ms) 를 포함한 시간은 보드에서 boot_upload.py 로 측정.
+"""
+
+import argparse
+import os
+import re
+import shlex
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HARNESS_SRC = os.path.join(ROOT, "tools", "boot_sim.c")
+HARNESS = os.path.join(ROOT, ".pio", "boot_sim")
+BOOT_ELF = os.path.join(ROOT, ".pio", "build", "boot", "firmware.elf")
+APP_IMAGE = os.path.join(ROOT, ".pio", "build", "ATmega128", "firmware.hex")
+UPLOAD = os.path.join(ROOT, "tools", "boot_upload.py")
+
+SIM_RE = re.compile(r"BOOT_SIM,(\w+),([^\s,]+)(?:,([^\s,]+))?")
+
+
+def build_harness():
+    if os.path.exists(HARNESS) and os.path.getmtime(HARNESS) >= os.path.getmtime(HARNESS_SRC):
+        return
+    try:
+        flags = subprocess.run(["pkg-config", "--cflags", "--libs", "simavr"],
+                               capture_output=True, text=True, check=True).stdout
+    except (FileNotFoundError, subprocess.CalledProcessError):
+        sys.exit("pkg-config simavr failed (simavr 개발 패키지 설치 확인)")
+    os.makedirs(os.path.dirname(HARNESS), exist_ok=True)
+    cmd = ["cc", "-O2", "-o", HARNESS, HARNESS_SRC] + shlex.split(flags) + ["-lelf"]
+    if subprocess.run(cmd).returncode:
+        sys.exit("harness build failed: %s" % " ".join(cmd))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="simavr bootloader update timing")
+    ap.add_argument("--boot-elf", default=BOOT_ELF)
+    ap.add_argument("--image", default=APP_IMAGE, help="app .hex / .bin")
+    ap.add_argument("--old-pages", type=int, default=0,
+                    help="이전 이미지 길이 [page] (0xA5 로 채움, 갱신 후 남으면 안 됨)")
+    args = ap.parse_args()
+
+    build_harness()
+    sim = subprocess.Popen([HARNESS, args.boot_elf, str(args.old_pages)],
+                           stdout=subprocess.PIPE, text=True)
+    m = SIM_RE.match(sim.stdout.readline())
+    if not m or m.group(1) != "pty":
+        sim.kill()
+        sys.exit("harness did not report a pty")
+
+    up = subprocess.run([sys.executable, UPLOAD, "-p", m.group(2), "--wait", "5", args.image])
+    out, _ = sim.communicate(timeout=120)
+
+    res = {m.group(1): m.groups()[1:] for m in SIM_RE.finditer(out)}
+    if up.returncode or sim.returncode or "cycles" not in res:
+        sys.exit("simulated update failed (upload %d, harness %d)" % (up.returncode, sim.returncode))
+
+    cycles, sec = res["cycles"]
+    stale = int(res["stale_pages"][0])
+    print("simavr: update %s s (%s cycles @ 16 MHz), stale pages %d"
+          % (sec, cycles, stale))
+    return 1 if stale else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
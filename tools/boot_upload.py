@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""
+File: boot_upload.py
+Author: Young Kwan CHO, Lilith
+Description: UART streaming 부트로더 (src/boot/boot.c, env:boot) 로
+             app 이미지(.hex / .bin)를 전송한다.
+             page 단위 block + CRC-16/XMODEM, ACK 받으면 다음 block 전송
+             (장치는 다음 block 수신 중에 이전 page 를 erase/write).
+
+Usage:
+  python tools/boot_upload.py -p COM5 .pio/build/ATmega128/firmware.hex
+  python tools/boot_upload.py -p /dev/ttyUSB0 -b 500000 firmware.bin
+  python tools/boot_upload.py --estimate firmware.hex      # 장치 없이 예상 시간만 (데이터시트 최대값 계산, 미측정)
+
+  실행 후 보드 reset → 부트로더가 BOOT_WAIT_MS 안에 'H' 를 받으면 갱신 시작.
+  simavr: python tools/boot_sim.py (tools/boot_sim.c 가 UART0 를 pty 로 연결 후 이 스크립트 실행).
+
+필요: pyserial (pip install pyserial)
+"""
+
+import argparse
+import binascii
+import struct
+import sys
+import time
+
+CMD_HELLO = b"H"
+CMD_BLOCK = b"B"
+CMD_DONE = b"D"
+ACK, NAK, ERR = 0x06, 0x15, 0x18
+
+PAGE_SIZE = 256
+FLASH_PAGE_MS = 9.0         # ATmega128 page erase + write (datasheet 최대 4.5ms × 2)
+FLASH_ERASE_MS = 4.5        # DONE: 새 이미지 뒤 남은 page erase (비어 있으면 생략)
+
+
+def load_image(path):
+    """Intel HEX 또는 raw binary → bytearray (빈 곳 0xFF)"""
+    if not path.lower().endswith(".hex"):
+        with open(path, "rb") as f:
+            return bytearray(f.read())
+
+    img = bytearray()
+    base = 0
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith(":"):
+                continue
+            rec = bytes.fromhex(line[1:])
+            if sum(rec) & 0xFF:
+                raise ValueError("hex checksum error: %s" % line)
+            n, addr, typ = rec[0], struct.unpack(">H", rec[1:3])[0], rec[3]
+            data = rec[4:4 + n]
+            if typ == 0x00:
+                end = base + addr + n
+                if end > len(img):
+                    img.extend(b"\xff" * (end - len(img)))
+                img[base + addr:end] = data
+            elif typ == 0x01:
+                break
+            elif typ == 0x02:
+                base = struct.unpack(">H", data)[0] << 4
+            elif typ == 0x04:
+                base = struct.unpack(">H", data)[0] << 16
+    return img
+
+
+def pages_of(img):
+    if len(img) % PAGE_SIZE:
+        img = img + b"\xff" * (PAGE_SIZE - len(img) % PAGE_SIZE)
+    return [bytes(img[i:i + PAGE_SIZE]) for i in range(0, len(img), PAGE_SIZE)]
+
+
+def frame(seq, data):
+    body = struct.pack("<H", seq) + data
+    return CMD_BLOCK + body + struct.pack(">H", binascii.crc_hqx(body, 0))
+
+
+def estimate(n_pages, baud):
+    """block 전송과 이전 page 기록이 겹침 → page 당 max(전송, 기록)
+       FLASH_PAGE_MS 는 데이터시트 최대값 → 상한 추정치 (보드/simavr 실측 아님)"""
+    frame_ms = (1 + 2 + PAGE_SIZE + 2 + 1) * 10 * 1000.0 / baud     # + ACK
+    per_page = max(frame_ms, FLASH_PAGE_MS)
+    return frame_ms + per_page * n_pages + FLASH_PAGE_MS            # 첫 전송 + page 0 (DONE)
+
+
+def sync(port, wait_s):
+    """reset 직후 창에 맞추기 위해 'H' 반복 전송 → 응답 정렬 후 1회 더"""
+    deadline = time.monotonic() + wait_s
+    port.timeout = 0.05
+    while time.monotonic() < deadline:
+        port.write(CMD_HELLO)
+        if port.read(1) == b"B":
+            break
+    else:
+        raise TimeoutError("no bootloader response (보드 reset 확인)")
+
+    time.sleep(0.1)
+    port.reset_input_buffer()
+    port.timeout = 1.0
+    port.write(CMD_HELLO)
+    hello = port.read(6)
+    if len(hello) != 6 or hello[:2] != b"BL":
+        raise IOError("bad hello reply %r" % hello)
+    return hello[2], 1 << hello[3], hello[4] | (hello[5] << 8)
+
+
+def upload(port, pages, retries, max_pages):
+    for seq, data in enumerate(pages):
+        pkt = frame(seq, data)
+        for _ in range(retries):
+            port.write(pkt)
+            r = port.read(1)
+            if r and r[0] == ACK:
+                break
+            if r and r[0] == ERR:
+                raise IOError("block %d rejected (범위 밖)" % seq)
+        else:
+            raise IOError("block %d: no ACK after %d tries" % (seq, retries))
+        sys.stdout.write("\r%d/%d pages" % (seq + 1, len(pages)))
+        sys.stdout.flush()
+    print()
+
+    # DONE 에서 이전 이미지 잔여 page erase → 최악의 경우 (max_pages - 새 이미지) × 4.5ms
+    port.timeout = 1.0 + (max_pages - len(pages)) * FLASH_ERASE_MS / 1000.0
+    port.write(CMD_DONE)
+    r = port.read(1)
+    if not r or r[0] != ACK:
+        raise IOError("DONE failed %r (verify 실패)" % r)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="UART streaming bootloader uploader")
+    ap.add_argument("image", help=".hex or .bin")
+    ap.add_argument("-p", "--port")
+    ap.add_argument("-b", "--baud", type=int, default=1000000, help="boot.c BOOT_BAUD")
+    ap.add_argument("--wait", type=float, default=10.0, help="reset 대기 [s]")
+    ap.add_argument("--retries", type=int, default=5)
+    ap.add_argument("--estimate", action="store_true", help="print expected time only")
+    args = ap.parse_args()
+
+    pages = pages_of(load_image(args.image))
+    est = estimate(len(pages), args.baud)
+    print("image: %d bytes, %d pages, estimated %.2f s @ %d baud (datasheet max, unmeasured)"
+          % (len(pages) * PAGE_SIZE, len(pages), est / 1000.0, args.baud))
+    if args.estimate:
+        return 0
+    if not args.port:
+        ap.error("--port required")
+
+    import serial   # pyserial, 실제 전송 시에만 필요
+
+    with serial.Serial(args.port, args.baud) as port:
+        ver, page, max_pages = sync(port, args.wait)
+        if page != PAGE_SIZE or len(pages) > max_pages:
+            sys.exit("image does not fit (page %d, max %d pages)" % (page, max_pages))
+        print("bootloader v%d, %d pages available" % (ver, max_pages))
+
+        t0 = time.monotonic()
+        upload(port, pages, args.retries, max_pages)
+        dt = time.monotonic() - t0
+
+    print("done: measured %.2f s, %.1f KB/s" % (dt, len(pages) * PAGE_SIZE / 1024.0 / dt))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
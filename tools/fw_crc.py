@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+File: fw_crc.py
+Author: Young Kwan CHO, Lilith
+Description: 빌드된 firmware.elf 의 flash 이미지 CRC-32 를 계산하여
+             fw_crc_info {magic, len, crc} (src/util/fw_crc.c) 에 기록한다.
+             len/crc 8byte 는 CRC 계산에서 제외 (펌웨어 fwCrcStep() 과 동일 규칙).
+
+Usage:
+  PlatformIO : extra_scripts = post:tools/fw_crc.py   (firmware.elf 생성 직후 자동 실행
+                                                       → hex 는 patch 된 elf 에서 생성)
+  CLI        : python tools/fw_crc.py .pio/build/ATmega128/firmware.elf
+               python tools/fw_crc.py --check firmware.elf   # 기록된 값 검증만
+
+외부 도구 없이 ELF32 (little endian) 를 직접 해석한다.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+SYMBOL = "fw_crc_info"
+MAGIC = 0x43524346          # "FCRC" (fw_crc.h FW_CRC_MAGIC)
+FLASH_LIMIT = 0x800000      # avr-gcc: RAM 0x800000~, EEPROM 0x810000~ 은 flash 가 아님
+PT_LOAD = 1
+SHT_SYMTAB = 2
+
+
+def read_elf(data):
+    if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+        raise ValueError("not an ELF32 little-endian file")
+
+    phoff, shoff = struct.unpack_from("<II", data, 0x1C)
+    phentsize, phnum, shentsize, shnum = struct.unpack_from("<HHHH", data, 0x2A)
+
+    segs = []
+    for i in range(phnum):
+        p_type, p_offset, _vaddr, p_paddr, p_filesz = struct.unpack_from("<IIIII", data, phoff + i * phentsize)
+        if p_type == PT_LOAD and p_filesz and p_paddr < FLASH_LIMIT:
+            segs.append((p_paddr, p_offset, p_filesz))
+
+    sections = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+    symbols = {}
+    for sh in sections:
+        if sh[1] != SHT_SYMTAB:
+            continue
+        strtab = sections[sh[6]]
+        for off in range(sh[4], sh[4] + sh[5], 16):
+            st_name, st_value = struct.unpack_from("<II", data, off)
+            end = data.index(b"\0", strtab[4] + st_name)
+            symbols[data[strtab[4] + st_name:end].decode()] = st_value
+
+    return segs, symbols
+
+
+def flash_image(data, segs):
+    """LMA 기준 flash 이미지 (.text + .data 초기값), 빈 곳은 0xFF"""
+    size = max(addr + n for addr, _off, n in segs)
+    img = bytearray(b"\xff" * size)
+    for addr, off, n in segs:
+        img[addr:addr + n] = data[off:off + n]
+    return img
+
+
+def file_offset(segs, addr):
+    for p_addr, p_off, n in segs:
+        if p_addr <= addr < p_addr + n:
+            return p_off + (addr - p_addr)
+    raise ValueError("address 0x%X not in a flash segment" % addr)
+
+
+def image_crc(img, info_addr):
+    skip = info_addr + 4                        # len, crc
+    crc = zlib.crc32(bytes(img[:skip]))
+    return zlib.crc32(bytes(img[skip + 8:]), crc) & 0xFFFFFFFF
+
+
+def patch(path, check_only=False):
+    with open(path, "rb") as f:
+        data = bytearray(f.read())
+
+    segs, symbols = read_elf(data)
+    if SYMBOL not in symbols:
+        print("fw_crc: %s not found (fw_crc.c not linked) - skip" % SYMBOL)
+        return 0
+
+    addr = symbols[SYMBOL]
+    off = file_offset(segs, addr)
+    magic, old_len, old_crc = struct.unpack_from("<III", data, off)
+    if magic != MAGIC:
+        raise ValueError("fw_crc: bad magic 0x%08X at 0x%X" % (magic, addr))
+
+    img = flash_image(data, segs)
+    length = len(img)
+    crc = image_crc(img, addr)
+
+    if check_only:
+        ok = (old_len, old_crc) == (length, crc)
+        print("fw_crc: len=%d crc=0x%08X stored=(%d, 0x%08X) %s"
+              % (length, crc, old_len, old_crc, "OK" if ok else "MISMATCH"))
+        return 0 if ok else 1
+
+    struct.pack_into("<II", data, off + 4, length, crc)
+    with open(path, "wb") as f:
+        f.write(data)
+
+    print("fw_crc: len=%d crc=0x%08X (@0x%X)" % (length, crc, addr))
+    return 0
+
+
+def pio_post_elf(source, target, env):
+    patch(str(target[0]))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="embed flash image CRC-32 into firmware.elf")
+    ap.add_argument("elf")
+    ap.add_argument("--check", action="store_true", help="verify stored value only")
+    args = ap.parse_args()
+    return patch(args.elf, args.check)
+
+
+try:
+    Import("env")  # noqa: F821  (PlatformIO extra_scripts 로 실행된 경우)
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", pio_post_elf)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main())
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+File: trace2json.py
+Author: Young Kwan CHO, Lilith
+Description: traceDump() 바이너리 → Chrome trace JSON 변환기
+             결과 파일은 chrome://tracing 또는 ui.perfetto.dev 에서 열 수 있다.
+
+Usage:
+  python tools/trace2json.py capture.bin -o trace.json
+  python tools/trace2json.py --port COM3 --baud 38400 -o trace.json   (pyserial 필요)
+
+입력은 UART 캡처 원본이어도 된다 (텍스트 로그 사이의 "TRC2" 블록을 모두 찾아 변환,
+이전 형식 "TRC1" 도 인식).
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# magic → record 형식 (id, ms, tick)
+FORMATS = {b"TRC2": "<BHB", b"TRC1": "<BHH"}
+
+PH_MASK = 0xC0
+PH_ENTER = 0x00
+PH_EXIT = 0x80
+PH_MARK = 0x40
+CODE_MASK = 0x3F
+
+# trace.h 의 코드 맵과 일치해야 함
+TASK_NAMES = ["task_1ms", "task_50ms", "task_100ms", "task_500ms"]
+
+
+def event_name(code):
+    """event code → (name, lane)"""
+    if code < 0x10:
+        name = TASK_NAMES[code] if code < len(TASK_NAMES) else "task_%d" % code
+        return name, "task"
+    if code == 0x10:
+        return "TIMER1_COMPA_vect", "isr"
+    if code < 0x20:
+        return "isr_0x%02X" % code, "isr"
+    if code == 0x20:
+        return "uartPrint", "uart"
+    if code < 0x28:
+        return "uart_0x%02X" % code, "uart"
+    return "user_%d" % (code - 0x28), "user"
+
+
+LANES = {"task": 1, "isr": 2, "uart": 3, "user": 4}
+
+
+def find_block(data, pos):
+    """가장 앞의 TRC1/TRC2 블록 위치 → (pos, record struct)"""
+    hits = [(data.find(m, pos), fmt) for m, fmt in FORMATS.items()]
+    hits = [h for h in hits if h[0] >= 0]
+    return min(hits) if hits else (-1, None)
+
+
+def parse_blocks(data):
+    """Find every trace block and yield list of (id, us)"""
+    pos = 0
+    while True:
+        pos, fmt = find_block(data, pos)
+        if pos < 0 or pos + 7 > len(data):
+            return
+        rec = struct.calcsize(fmt)
+        count, tick_us = struct.unpack_from("<HB", data, pos + 4)
+        body = pos + 7
+        if body + count * rec > len(data):
+            print("warning: truncated block at offset %d" % pos, file=sys.stderr)
+            return
+
+        events = []
+        base = 0          # ms 16bit wrap 보정
+        prev_ms = None
+        for i in range(count):
+            eid, ms, tick = struct.unpack_from(fmt, data, body + i * rec)
+            if prev_ms is not None and ms < prev_ms and prev_ms - ms > 0x8000:
+                base += 0x10000
+            prev_ms = ms
+            # 미처리 tick (OCF1A) 보정은 traceRecord() 에서 완료된 값
+            us = (base + ms) * 1000 + tick * tick_us
+            events.append((eid, us))
+        yield events
+        pos = body + count * rec
+
+
+def to_chrome(events):
+    out = []
+    for lane, tid in LANES.items():
+        out.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid,
+                    "args": {"name": lane}})
+
+    t0 = events[0][1] if events else 0
+    for eid, us in events:
+        name, lane = event_name(eid & CODE_MASK)
+        ph = eid & PH_MASK
+        ev = {"name": name, "pid": 1, "tid": LANES[lane], "ts": us - t0}
+        if ph == PH_ENTER:
+            ev["ph"] = "B"
+        elif ph == PH_EXIT:
+            ev["ph"] = "E"
+        else:
+            ev["ph"] = "i"
+            ev["s"] = "t"
+        out.append(ev)
+    return {"traceEvents": out, "displayTimeUnit": "ns"}
+
+
+def read_serial(port, baud, seconds):
+    import serial  # pyserial
+    with serial.Serial(port, baud, timeout=seconds) as ser:
+        return ser.read(1 << 20)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="traceDump() binary → Chrome trace JSON")
+    ap.add_argument("input", nargs="?", help="captured binary file")
+    ap.add_argument("--port", help="read directly from serial port")
+    ap.add_argument("--baud", type=int, default=38400)
+    ap.add_argument("--timeout", type=float, default=3.0, help="serial read timeout [s]")
+    ap.add_argument("-o", "--output", default="trace.json")
+    args = ap.parse_args()
+
+    if args.port:
+        data = read_serial(args.port, args.baud, args.timeout)
+    elif args.input:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        ap.error("input file or --port required")
+
+    blocks = list(parse_blocks(data))
+    if not blocks:
+        print("no TRC1/TRC2 block found", file=sys.stderr)
+        return 1
+
+    events = blocks[-1]   # 가장 최근 덤프
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(events), f, indent=1)
+    print("%d events → %s" % (len(events), args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())